@@ -0,0 +1,251 @@
+#ifndef ASSETMANAGER_H
+#define ASSETMANAGER_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <SFML/Graphics.hpp>
+#include "workStealing.h"
+#ifdef MINES_EMBEDDED_ASSETS
+#include "embeddedAssets.h" // Generated by cmake/embedAssets.cmake
+#endif
+using namespace std;
+
+// Every image, font and text file the game uses, loaded once and shared by
+// all windows. preload starts decoding images into sf::Image on worker
+// threads and returns, so windows can be created meanwhile; texture then
+// waits for just the image it needs and uploads it on the calling thread,
+// which must be the one with the GL context. Only preload's workers run
+// off that thread. Anything that fails to load throws runtime_error when
+// it is first asked for.
+//
+// Builds with MINES_EMBEDDED_ASSETS read the font and images from the
+// copies compiled into the binary, so startup opens no asset files. The
+// config is settings rather than an asset and is never embedded, so
+// edits to files/config.cfg apply without a rebuild. A file at the same
+// path under mods/ (e.g. mods/files/images/flag.png) overrides either.
+class AssetManager {
+private:
+    struct ImageSlot {
+        string path;
+        sf::Image image;
+        bool done = false;
+        bool ok = false;
+    };
+
+    mutex lock;
+    condition_variable decoded;
+    map<string, unique_ptr<ImageSlot>> images;
+    map<string, unique_ptr<sf::Texture>> textures;
+    map<string, unique_ptr<sf::Font>> fonts;
+    map<string, string> files;   // Raw contents; fonts are read from these
+    thread loader;
+
+    const string overrideDir = "mods/";
+    bool overridesPresent = pathExists("mods"); // Without mods/, no per-asset checks
+
+    chrono::steady_clock::time_point timerStart = chrono::steady_clock::now();
+    double decodeMillis = 0;
+    unsigned decodeThreads = 0;
+    size_t decodeCount = 0;
+
+    static double millisSince(chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    static bool pathExists(const string &path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0;
+    }
+
+    // The file under mods/ standing in for path, or "" if there is none
+    string overridePath(const string &path) const {
+        if (overridesPresent && pathExists(overrideDir + path)) return overrideDir + path;
+        return "";
+    }
+
+    // The compiled-in copy of path, or nullptr
+    static const unsigned char *embedded(const string &path, size_t &size) {
+#ifdef MINES_EMBEDDED_ASSETS
+        for (size_t i = 0; i < embeddedAssetCount; ++i) {
+            if (path == embeddedAssets[i].path) {
+                size = embeddedAssets[i].size;
+                return embeddedAssets[i].data;
+            }
+        }
+#else
+        (void)path;
+#endif
+        size = 0;
+        return nullptr;
+    }
+
+    // Override first, then the embedded copy, then the file itself
+    bool decodeImage(const string &path, sf::Image &image) const {
+        string override = overridePath(path);
+        if (!override.empty()) return image.loadFromFile(override);
+        size_t size;
+        if (const unsigned char *data = embedded(path, size)) return image.loadFromMemory(data, size);
+        return image.loadFromFile(path);
+    }
+
+    // The slot for path, decoding it here if preload never queued it
+    ImageSlot &waitForImage(const string &path) {
+        unique_lock<mutex> guard(lock);
+        auto it = images.find(path);
+        if (it == images.end()) {
+            unique_ptr<ImageSlot> slot(new ImageSlot);
+            slot->path = path;
+            it = images.emplace(path, move(slot)).first;
+            ImageSlot &own = *it->second;
+            guard.unlock();
+            bool ok = decodeImage(path, own.image);
+            guard.lock();
+            own.ok = ok;
+            own.done = true;
+            decoded.notify_all();
+        }
+        ImageSlot &slot = *it->second;
+        decoded.wait(guard, [&] { return slot.done; });
+        return slot;
+    }
+
+public:
+    AssetManager() {}
+    ~AssetManager() {
+        if (loader.joinable()) loader.join();
+    }
+
+    AssetManager(const AssetManager &) = delete;
+    AssetManager &operator=(const AssetManager &) = delete;
+
+    // The instance all windows share
+    static AssetManager &shared() {
+        static AssetManager assets;
+        return assets;
+    }
+
+    // Start decoding images on up to threads workers and return at once
+    void preload(const vector<string> &paths, unsigned threads = thread::hardware_concurrency()) {
+        if (loader.joinable()) loader.join();
+        vector<ImageSlot *> queued;
+        {
+            lock_guard<mutex> guard(lock);
+            for (const string &path : paths) {
+                if (images.count(path)) continue;
+                unique_ptr<ImageSlot> slot(new ImageSlot);
+                slot->path = path;
+                queued.push_back(slot.get());
+                images.emplace(path, move(slot));
+            }
+        }
+        if (queued.empty()) return;
+
+        threads = max(1u, min(threads, static_cast<unsigned>(queued.size())));
+        loader = thread([this, queued, threads] {
+            auto start = chrono::steady_clock::now();
+            parallelForStealing(queued.size(), threads, 1, [&](unsigned, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    bool ok = decodeImage(queued[i]->path, queued[i]->image);
+                    lock_guard<mutex> guard(lock);
+                    queued[i]->ok = ok;
+                    queued[i]->done = true;
+                    decoded.notify_all();
+                }
+            });
+            lock_guard<mutex> guard(lock);
+            decodeMillis = millisSince(start);
+            decodeThreads = threads;
+            decodeCount = queued.size();
+        });
+    }
+
+    // Decoded pixels, e.g. for composing an atlas
+    const sf::Image &image(const string &path) {
+        ImageSlot &slot = waitForImage(path);
+        if (!slot.ok) throw runtime_error("Unable to load " + path);
+        return slot.image;
+    }
+
+    // GPU copy of an image, uploaded on first use
+    const sf::Texture &texture(const string &path) {
+        unique_ptr<sf::Texture> &texture = textures[path];
+        if (!texture) {
+            unique_ptr<sf::Texture> loaded(new sf::Texture);
+            if (!loaded->loadFromImage(image(path))) throw runtime_error("Unable to upload " + path);
+            texture = move(loaded);
+        }
+        return *texture;
+    }
+
+    // Whole file contents, read once
+    const string &file(const string &path) {
+        lock_guard<mutex> guard(lock);
+        auto it = files.find(path);
+        if (it == files.end()) {
+            string source = overridePath(path);
+            size_t size;
+            const unsigned char *data = source.empty() ? embedded(path, size) : nullptr;
+            if (data) {
+                it = files.emplace(path, string(reinterpret_cast<const char *>(data), size)).first;
+            } else {
+                if (source.empty()) source = path;
+                ifstream in(source, ios::binary);
+                if (!in) throw runtime_error("Unable to open " + source);
+                ostringstream contents;
+                contents << in.rdbuf();
+                it = files.emplace(path, contents.str()).first;
+            }
+        }
+        return it->second;
+    }
+
+    // Fonts read their glyphs from the embedded or cached file as they are
+    // needed
+    const sf::Font &font(const string &path) {
+        unique_ptr<sf::Font> &font = fonts[path];
+        if (!font) {
+            unique_ptr<sf::Font> loaded(new sf::Font);
+            size_t size;
+            const unsigned char *data = overridePath(path).empty() ? embedded(path, size) : nullptr;
+            bool ok;
+            if (data) {
+                ok = loaded->loadFromMemory(data, size);
+            } else {
+                const string &bytes = file(path);
+                ok = loaded->loadFromMemory(bytes.data(), bytes.size());
+            }
+            if (!ok) throw runtime_error("Unable to load font " + path);
+            font = move(loaded);
+        }
+        return *font;
+    }
+
+    // Time-to-first-frame is measured from here; the manager's creation
+    // starts the first measurement
+    void startTimer() { timerStart = chrono::steady_clock::now(); }
+
+    // Log how long a window took to show its first frame
+    void logFirstFrame(const string &window) {
+        double millis = millisSince(timerStart);
+        lock_guard<mutex> guard(lock);
+        cout << window << ": first frame after " << millis << " ms";
+        if (decodeCount > 0) {
+            cout << " (" << decodeCount << " images decoded in " << decodeMillis << " ms on " << decodeThreads
+                 << " threads)";
+        }
+        cout << endl;
+    }
+};
+
+#endif //ASSETMANAGER_H
@@ -0,0 +1,124 @@
+#ifndef ATOMICFILE_H
+#define ATOMICFILE_H
+
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Replace path with data so readers see either the old file or the new
+// one, never a mix: write a temporary file beside it, flush it to disk,
+// then rename it over the original. Throws runtime_error on failure and
+// leaves the original untouched.
+inline void writeFileAtomically(const string &path, const void *data, size_t size) {
+    string temp = path + ".tmp";
+    FILE *file = fopen(temp.c_str(), "wb");
+    if (!file) throw runtime_error("Unable to create " + temp);
+    bool ok = fwrite(data, 1, size, file) == size && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = fclose(file) == 0 && ok;
+#ifdef _WIN32
+    ok = ok && MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    ok = ok && rename(temp.c_str(), path.c_str()) == 0;
+#endif
+    if (!ok) {
+        remove(temp.c_str());
+        throw runtime_error("Unable to write " + path);
+    }
+}
+
+// Read-only memory map of a whole file. Pages are loaded on first touch,
+// so opening is constant time whatever the file size.
+class MappedFile {
+private:
+    const uint8_t *bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() { close(); }
+
+    // False if the file is missing or can't be mapped; empty files map
+    // to no bytes
+    bool open(const string &path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            close();
+            return false;
+        }
+        length = static_cast<size_t>(fileSize.QuadPart);
+        if (length == 0) return true;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) bytes = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) {
+            ::close(fd);
+            return true;
+        }
+        void *view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file alive
+        if (view != MAP_FAILED) bytes = static_cast<const uint8_t *>(view);
+#endif
+        if (!bytes) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) munmap(const_cast<uint8_t *>(bytes), length);
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const uint8_t *data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif //ATOMICFILE_H
@@ -0,0 +1,130 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+// Minimal timing harness: warmup runs, timed repetitions, percentiles and
+// JSON output, with no dependencies beyond the standard library.
+class BenchHarness {
+public:
+    struct Result {
+        string name;
+        string params;
+        size_t repetitions = 0;
+        size_t inner = 1;   // Operations per repetition
+        // Microseconds per operation
+        double min = 0, p50 = 0, p90 = 0, p99 = 0, max = 0, mean = 0;
+    };
+
+private:
+    int warmup = 3;
+    int repetitions = 30;
+    string filter;
+    vector<Result> results;
+
+    static double percentile(const vector<double> &sorted, double p) {
+        if (sorted.empty()) return 0;
+        double rank = p * (sorted.size() - 1);
+        size_t low = static_cast<size_t>(rank);
+        size_t high = min(low + 1, sorted.size() - 1);
+        return sorted[low] + (sorted[high] - sorted[low]) * (rank - low);
+    }
+
+    static string escape(const string &text) {
+        string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    void setWarmup(int runs) { warmup = max(0, runs); }
+    void setRepetitions(int runs) { repetitions = max(1, runs); }
+
+    // Only run benchmarks whose name or params contain text
+    void setFilter(const string &text) { filter = text; }
+
+    // Time body() over the repetitions, calling setup() untimed before each
+    // one. body performs inner operations; times are reported per operation.
+    template <class Setup, class Body>
+    void run(const string &name, const string &params, Setup setup, Body body, size_t inner = 1) {
+        if (!filter.empty() && name.find(filter) == string::npos && params.find(filter) == string::npos) return;
+
+        for (int i = 0; i < warmup; ++i) {
+            setup();
+            body();
+        }
+
+        vector<double> samples;
+        samples.reserve(repetitions);
+        for (int i = 0; i < repetitions; ++i) {
+            setup();
+            auto start = chrono::steady_clock::now();
+            body();
+            double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+            samples.push_back(micros / inner);
+        }
+        sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.params = params;
+        result.repetitions = samples.size();
+        result.inner = inner;
+        result.min = samples.front();
+        result.max = samples.back();
+        result.p50 = percentile(samples, 0.50);
+        result.p90 = percentile(samples, 0.90);
+        result.p99 = percentile(samples, 0.99);
+        double total = 0;
+        for (double sample : samples) total += sample;
+        result.mean = total / samples.size();
+        results.push_back(result);
+
+        printRow(cout, result);
+    }
+
+    template <class Body>
+    void run(const string &name, const string &params, Body body, size_t inner = 1) {
+        run(name, params, [] {}, body, inner);
+    }
+
+    static void printHeader(ostream &out) {
+        out << left << setw(20) << "benchmark" << setw(24) << "params" << right
+            << setw(12) << "p50 us" << setw(12) << "p90 us" << setw(12) << "p99 us"
+            << setw(12) << "min us" << setw(12) << "max us" << "\n";
+    }
+
+    static void printRow(ostream &out, const Result &result) {
+        out << left << setw(20) << result.name << setw(24) << result.params << right << fixed << setprecision(3)
+            << setw(12) << result.p50 << setw(12) << result.p90 << setw(12) << result.p99
+            << setw(12) << result.min << setw(12) << result.max << "\n";
+    }
+
+    void writeJson(ostream &out) const {
+        out << "{\n  \"warmup\": " << warmup << ",\n  \"repetitions\": " << repetitions
+            << ",\n  \"unit\": \"us/op\",\n  \"results\": [\n";
+        out << setprecision(6) << fixed;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            out << "    {\"name\": \"" << escape(r.name) << "\", \"params\": \"" << escape(r.params)
+                << "\", \"repetitions\": " << r.repetitions << ", \"inner\": " << r.inner
+                << ", \"min\": " << r.min << ", \"p50\": " << r.p50 << ", \"p90\": " << r.p90
+                << ", \"p99\": " << r.p99 << ", \"max\": " << r.max << ", \"mean\": " << r.mean << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    const vector<Result> &getResults() const { return results; }
+};
+
+#endif //BENCHHARNESS_H
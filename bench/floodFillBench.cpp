@@ -0,0 +1,95 @@
+// Compares the engine's scanline flood fill with the queue-based BFS it
+// replaced, on large sparse boards where one click opens most of the board.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <queue>
+#include <vector>
+#include "gameEngine.h"
+
+using namespace std;
+
+// The previous reveal: BFS through a queue, collecting neighbor lists
+static int bfsReveal(Board &board, int start) {
+    vector<int> neighbors;
+    queue<int> toReveal;
+    int revealed = 1;
+    board.setRevealed(start);
+    if (board.adjacentMines(start) == 0) toReveal.push(start);
+
+    while (!toReveal.empty()) {
+        int current = toReveal.front();
+        toReveal.pop();
+
+        board.neighbors(board.rowOf(current), board.colOf(current), neighbors);
+        for (int n : neighbors) {
+            if (board.isRevealed(n) || board.isMine(n) || board.isFlagged(n)) continue;
+            board.setRevealed(n);
+            revealed++;
+            if (board.adjacentMines(n) == 0) toReveal.push(n);
+        }
+    }
+    return revealed;
+}
+
+// First zero cell, so both fills open the same region
+static int findZeroCell(const Board &board) {
+    for (int n = 0; n < board.size(); ++n) {
+        int i = board.indexOfNth(n);
+        if (!board.isMine(i) && board.adjacentMines(i) == 0) return i;
+    }
+    return -1;
+}
+
+static double millisSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const int repetitions = 5;
+    const int sizes[][3] = {
+        {100, 100, 100},
+        {1000, 1000, 10000},
+        {1000, 1000, 100000},
+        {2000, 2000, 40000},
+    };
+
+    cout << left << setw(22) << "board" << setw(12) << "revealed"
+         << setw(12) << "bfs ms" << setw(12) << "scan ms" << "speedup\n";
+
+    for (const auto &size : sizes) {
+        int cols = size[0], rows = size[1], mines = size[2];
+        GameEngine engine(cols, rows, mines);
+        engine.reset(12345);
+        const Board fresh = engine.getBoard();
+        int start = findZeroCell(fresh);
+        if (start < 0) continue;
+
+        double bfsBest = 1e30, scanBest = 1e30;
+        int bfsCount = 0, scanCount = 0;
+        for (int rep = 0; rep < repetitions; ++rep) {
+            Board board = fresh;
+            auto t0 = chrono::steady_clock::now();
+            bfsCount = bfsReveal(board, start);
+            bfsBest = min(bfsBest, millisSince(t0));
+
+            engine.reset(12345);
+            t0 = chrono::steady_clock::now();
+            engine.reveal(fresh.rowOf(start), fresh.colOf(start));
+            scanBest = min(scanBest, millisSince(t0));
+            scanCount = static_cast<int>(engine.getChangedCells().size());
+        }
+
+        if (bfsCount != scanCount) {
+            cerr << "Mismatch: bfs revealed " << bfsCount << ", scanline " << scanCount << "\n";
+            return 1;
+        }
+
+        string label = to_string(cols) + "x" + to_string(rows) + " / " + to_string(mines);
+        cout << left << setw(22) << label << setw(12) << scanCount
+             << setw(12) << fixed << setprecision(3) << bfsBest
+             << setw(12) << scanBest << setprecision(2) << bfsBest / scanBest << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Microbenchmarks for the game's hot paths across board sizes and
+// densities: mine placement, adjacency counting, flood-fill reveal, win
+// checks, board reset, game save/load and leaderboard load/save/submit.
+//
+// usage: mines_bench [--reps N] [--warmup N] [--filter TEXT] [--json PATH]
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <stdexcept>
+#include "benchHarness.h"
+#include "gameEngine.h"
+#include "leaderboardStore.h"
+#include "saveGame.h"
+
+using namespace std;
+
+struct BoardCase {
+    int cols, rows, mines;
+};
+
+static string label(const BoardCase &size) {
+    return to_string(size.cols) + "x" + to_string(size.rows) + "/" + to_string(size.mines);
+}
+
+// Keeps the optimizer from dropping results nobody reads
+static volatile long long sink = 0;
+
+// First zero cell, so every repetition opens the same region
+static int firstZeroCell(const Board &board) {
+    for (int n = 0; n < board.size(); ++n) {
+        int idx = board.indexOfNth(n);
+        if (!board.isMine(idx) && board.adjacentMines(idx) == 0) return idx;
+    }
+    return -1;
+}
+
+static void benchBoards(BenchHarness &harness) {
+    const BoardCase cases[] = {
+        {9, 9, 10},
+        {16, 16, 40},
+        {30, 16, 99},
+        {100, 100, 1000},
+        {100, 100, 2000},
+        {1000, 1000, 10000},
+        {1000, 1000, 100000},
+        {1000, 1000, 200000},
+    };
+
+    for (const BoardCase &size : cases) {
+        string params = label(size);
+        Board board(size.cols, size.rows);
+        FastRng rng(1);
+
+        harness.run("place_mines", params, [&] { board.clear(); rng.seed(1); },
+                    [&] { MinePlacer::place(board, size.mines, rng); });
+
+        harness.run("adjacency", params, [&] { board.computeAdjacentCounts(); });
+
+        // Game reset, which also places the mines when not first-click-safe
+        GameEngine engine(size.cols, size.rows, size.mines);
+        harness.run("reset", params, [&] { engine.reset(7); });
+
+        // Flood fill from a zero cell of the same board every time
+        engine.reset(7);
+        int start = firstZeroCell(engine.getBoard());
+        if (start >= 0) {
+            int row = engine.getBoard().rowOf(start), col = engine.getBoard().colOf(start);
+            harness.run("flood_reveal", params, [&] { engine.reset(7); }, [&] { engine.reveal(row, col); });
+        }
+
+        // The engine's win check is a counter; compare with a full scan
+        const size_t checks = 100000;
+        harness.run("win_check_counter", params, [&] {
+            long long total = 0;
+            for (size_t i = 0; i < checks; ++i) total += engine.getHiddenSafeCells() == 0;
+            sink = sink + total;
+        }, checks);
+        harness.run("win_check_scan", params, [&] { sink = sink + (engine.getBoard().countHiddenSafe() == 0); });
+
+        // Snapshot of the half-played game above, written and mapped back
+        const string savePath = "mines_bench_save.bin";
+        Replay noMoves;
+        harness.run("save_game", params, [&] { SaveGame::save(savePath, engine, 1000, noMoves); });
+        GameEngine restored;
+        uint32_t played = 0;
+        Replay moves;
+        harness.run("load_game", params, [&] { sink = sink + SaveGame::load(savePath, restored, played, moves); });
+        remove(savePath.c_str());
+    }
+}
+
+static void benchLeaderboard(BenchHarness &harness) {
+    const string path = "mines_bench_leaderboard.txt";
+    const char *names[] = {"Alex", "Bruce", "Carl", "Dan", "Eve"};
+    for (int entries : {5, 100000}) {
+        {
+            // Spread over many boards so the current one still has a table
+            ofstream seed(path, ios::trunc);
+            for (int i = 0; i < entries; ++i) {
+                seed << 25 + i / 500 << ",16," << 50 + i % 7 << "," << 421000 + i * 37 << "," << names[i % 5] << i
+                     << "\n";
+            }
+        }
+
+        string params = to_string(entries) + " entries";
+        Leaderboard leaderboard(path);
+        leaderboard.setBoard(25, 16, 50);
+        harness.run("leaderboard_resort", params, [&] { leaderboard.load(); });
+        leaderboard.save(); // Sorted, as every file the game writes is
+        harness.run("leaderboard_load", params, [&] { leaderboard.load(); });
+        harness.run("leaderboard_save", params, [&] { leaderboard.save(); });
+        harness.run("leaderboard_add", params, [&] { leaderboard.addScore("Bench", 600000); });
+
+        // What a win costs the game thread; the writes are batched behind it
+        LeaderboardStore store(path);
+        harness.run("leaderboard_submit", params, [&] { store.submit(25, 16, 50, "Bench", 600000); });
+        store.flush();
+    }
+    remove(path.c_str());
+}
+
+int main(int argc, char **argv) {
+    BenchHarness harness;
+    string jsonPath;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (i + 1 >= argc) throw invalid_argument("Missing value for " + arg);
+            string value = argv[++i];
+            if (arg == "--reps") harness.setRepetitions(stoi(value));
+            else if (arg == "--warmup") harness.setWarmup(stoi(value));
+            else if (arg == "--filter") harness.setFilter(value);
+            else if (arg == "--json") jsonPath = value;
+            else throw invalid_argument("Unknown option " + arg);
+        }
+    } catch (const exception &e) {
+        cerr << "usage: mines_bench [--reps N] [--warmup N] [--filter TEXT] [--json PATH]\n" << e.what() << "\n";
+        return 1;
+    }
+
+    BenchHarness::printHeader(cout);
+    benchBoards(harness);
+    benchLeaderboard(harness);
+
+    if (!jsonPath.empty()) {
+        ofstream json(jsonPath, ios::trunc);
+        if (!json) {
+            cerr << "Unable to write " << jsonPath << "\n";
+            return 1;
+        }
+        harness.writeJson(json);
+    }
+    return 0;
+}
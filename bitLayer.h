@@ -0,0 +1,163 @@
+#ifndef BITLAYER_H
+#define BITLAYER_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+using namespace std;
+
+inline int popcount64(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(word));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Index of the lowest set bit; word must be nonzero
+inline int countTrailingZeros64(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    return popcount64((word & (0 - word)) - 1);
+#endif
+}
+
+// One bit per cell, each row padded to whole 64-bit words. Bits past the
+// last column are always zero so shifts never leak padding into counts.
+class BitLayer {
+private:
+    int cols = 0;
+    int rows = 0;
+    int wordsPerRow = 0;
+    vector<uint64_t> words;
+
+    // Add a one-bit-per-cell mask into four bit-sliced count planes
+    static void addPlane(uint64_t x, uint64_t &b0, uint64_t &b1, uint64_t &b2, uint64_t &b3) {
+        uint64_t c0 = b0 & x;
+        b0 ^= x;
+        uint64_t c1 = b1 & c0;
+        b1 ^= c0;
+        uint64_t c2 = b2 & c1;
+        b2 ^= c1;
+        b3 |= c2;
+    }
+
+    uint64_t wordAt(int row, int w) const {
+        if (row < 0 || row >= rows || w < 0 || w >= wordsPerRow) return 0;
+        return words[row * wordsPerRow + w];
+    }
+
+    // Cells whose west (c - 1) neighbor bit is set
+    uint64_t westOf(int row, int w) const {
+        return (wordAt(row, w) << 1) | (wordAt(row, w - 1) >> 63);
+    }
+
+    // Cells whose east (c + 1) neighbor bit is set
+    uint64_t eastOf(int row, int w) const {
+        return (wordAt(row, w) >> 1) | (wordAt(row, w + 1) << 63);
+    }
+
+public:
+    BitLayer() {}
+    BitLayer(int cols, int rows) { resize(cols, rows); }
+
+    void resize(int newCols, int newRows) {
+        cols = newCols;
+        rows = newRows;
+        wordsPerRow = (cols + 63) / 64;
+        words.assign(static_cast<size_t>(wordsPerRow) * rows, 0);
+    }
+
+    void clear() { fill(words.begin(), words.end(), 0); }
+
+    bool test(int row, int col) const {
+        return (words[row * wordsPerRow + (col >> 6)] >> (col & 63)) & 1;
+    }
+
+    void set(int row, int col, bool value = true) {
+        uint64_t bit = 1ULL << (col & 63);
+        uint64_t &word = words[row * wordsPerRow + (col >> 6)];
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    // Set row's bits from one byte per cell: bit c is set when cells[c]
+    // has bit shift set. Packs eight cells per multiply.
+    void setRowFromBytes(int row, const uint8_t *cells, int shift) {
+        uint64_t *out = &words[static_cast<size_t>(row) * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            int base = w * 64;
+            int end = min(64, cols - base);
+            uint64_t word = 0;
+            int bit = 0;
+            for (; bit + 8 <= end; bit += 8) {
+                uint64_t eight;
+                memcpy(&eight, cells + base + bit, 8);
+                uint64_t packed = (((eight >> shift) & 0x0101010101010101ULL) * 0x0102040810204080ULL) >> 56;
+                word |= packed << bit;
+            }
+            for (; bit < end; ++bit) word |= static_cast<uint64_t>((cells[base + bit] >> shift) & 1) << bit;
+            out[w] = word;
+        }
+    }
+
+    // Call f(row, col) for every set bit, in row-major order
+    template <class F>
+    void forEachSet(F f) const {
+        for (int r = 0; r < rows; ++r) {
+            for (int w = 0; w < wordsPerRow; ++w) {
+                for (uint64_t word = words[static_cast<size_t>(r) * wordsPerRow + w]; word; word &= word - 1) {
+                    f(r, w * 64 + countTrailingZeros64(word));
+                }
+            }
+        }
+    }
+
+    int count() const {
+        int total = 0;
+        for (uint64_t word : words) total += popcount64(word);
+        return total;
+    }
+
+    // Write the number of set neighbors of every cell in row into out
+    // (cols entries). Each 64-bit word yields 64 counts at once via
+    // bit-sliced adds of the eight shifted neighbor masks.
+    void rowNeighborCounts(int r, uint8_t *out) const {
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+            addPlane(wordAt(r - 1, w), b0, b1, b2, b3);
+            addPlane(westOf(r - 1, w), b0, b1, b2, b3);
+            addPlane(eastOf(r - 1, w), b0, b1, b2, b3);
+            addPlane(westOf(r, w), b0, b1, b2, b3);
+            addPlane(eastOf(r, w), b0, b1, b2, b3);
+            addPlane(wordAt(r + 1, w), b0, b1, b2, b3);
+            addPlane(westOf(r + 1, w), b0, b1, b2, b3);
+            addPlane(eastOf(r + 1, w), b0, b1, b2, b3);
+
+            int base = w * 64;
+            int end = min(64, cols - base);
+            for (int bit = 0; bit < end; ++bit) {
+                out[base + bit] = static_cast<uint8_t>(((b0 >> bit) & 1) | (((b1 >> bit) & 1) << 1) |
+                                                       (((b2 >> bit) & 1) << 2) | (((b3 >> bit) & 1) << 3));
+            }
+        }
+    }
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+};
+
+#endif //BITLAYER_H
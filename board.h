@@ -0,0 +1,192 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <vector>
+#include <cstdint>
+#include "bitLayer.h"
+using namespace std;
+
+// Snapshot of a single cell, no rendering data
+struct Cell {
+    bool mine = false;
+    bool revealed = false;
+    bool flagged = false;
+    int adjacentMines = 0;
+};
+
+// Row-major grid packing each cell into one byte: the adjacent mine count
+// in the low nibble plus mine, revealed and flagged bits. The grid has a
+// one-cell border of sentinel bytes, so index arithmetic never leaves the
+// array and the 8 neighbors of any cell are at fixed offsets. Sentinels
+// look revealed, which stops fills without bounds checks. Mines are also
+// kept in a bit layer, from which all neighbor counts are computed at once.
+//
+// Cell indices address the padded grid: use index/rowOf/colOf to convert,
+// and indexOfNth/ordinalOf to walk the cols * rows real cells densely.
+class Board {
+public:
+    enum : uint8_t {
+        CountMask = 0x0F,
+        MineShift = 4,
+        MineBit = 1 << MineShift,
+        RevealedBit = 0x20,
+        FlaggedBit = 0x40,
+        BorderBit = 0x80
+    };
+
+private:
+    int cols = 0;
+    int rows = 0;
+    int stride = 2; // cols + 2
+    int offsets[8] = {};
+    vector<uint8_t> cells;
+    BitLayer mineLayer;
+
+    void setBit(int idx, uint8_t bit, bool value) {
+        cells[idx] = value ? (cells[idx] | bit) : (cells[idx] & ~bit);
+    }
+
+    void fillBorder() {
+        const uint8_t sentinel = BorderBit | RevealedBit;
+        for (int c = 0; c < stride; ++c) {
+            cells[c] = sentinel;
+            cells[static_cast<size_t>(rows + 1) * stride + c] = sentinel;
+        }
+        for (int r = 1; r <= rows; ++r) {
+            cells[static_cast<size_t>(r) * stride] = sentinel;
+            cells[static_cast<size_t>(r) * stride + cols + 1] = sentinel;
+        }
+    }
+
+public:
+    Board() {}
+    Board(int cols, int rows) { resize(cols, rows); }
+
+    void resize(int newCols, int newRows) {
+        cols = newCols;
+        rows = newRows;
+        stride = cols + 2;
+        int i = 0;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if (dr || dc) offsets[i++] = dr * stride + dc;
+            }
+        }
+        cells.assign(static_cast<size_t>(rows + 2) * stride, 0);
+        mineLayer.resize(cols, rows);
+        fillBorder();
+    }
+
+    void clear() {
+        fill(cells.begin(), cells.end(), 0);
+        mineLayer.clear();
+        fillBorder();
+    }
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    int getStride() const { return stride; }
+    int size() const { return cols * rows; }
+
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+
+    int index(int row, int col) const { return (row + 1) * stride + col + 1; }
+    int rowOf(int idx) const { return idx / stride - 1; }
+    int colOf(int idx) const { return idx % stride - 1; }
+
+    // Dense numbering of the real cells, 0 .. size() - 1 in row-major order
+    int indexOfNth(int n) const { return index(n / cols, n % cols); }
+    int ordinalOf(int idx) const { return rowOf(idx) * cols + colOf(idx); }
+
+    // Offset from a cell's index to each of its 8 neighbors
+    const int *neighborOffsets() const { return offsets; }
+
+    uint8_t raw(int idx) const { return cells[idx]; }
+    bool isBorder(int idx) const { return (cells[idx] & BorderBit) != 0; }
+
+    bool isMine(int idx) const { return (cells[idx] & MineBit) != 0; }
+    bool isRevealed(int idx) const { return (cells[idx] & RevealedBit) != 0; }
+    bool isFlagged(int idx) const { return (cells[idx] & FlaggedBit) != 0; }
+    int adjacentMines(int idx) const { return cells[idx] & CountMask; }
+
+    // Counts are stale until computeAdjacentCounts runs
+    void setMine(int idx, bool value = true) {
+        setBit(idx, MineBit, value);
+        mineLayer.set(rowOf(idx), colOf(idx), value);
+    }
+    void setRevealed(int idx, bool value = true) { setBit(idx, RevealedBit, value); }
+    void setFlagged(int idx, bool value = true) { setBit(idx, FlaggedBit, value); }
+
+    bool isMine(int row, int col) const { return isMine(index(row, col)); }
+    bool isRevealed(int row, int col) const { return isRevealed(index(row, col)); }
+    bool isFlagged(int row, int col) const { return isFlagged(index(row, col)); }
+    int adjacentMines(int row, int col) const { return adjacentMines(index(row, col)); }
+    void setRevealed(int row, int col, bool value = true) { setRevealed(index(row, col), value); }
+
+    // Recount the mines around every cell from the mine layer, one row of
+    // counts at a time into the low nibbles
+    void computeAdjacentCounts() {
+        vector<uint8_t> rowCounts(cols);
+        for (int r = 0; r < rows; ++r) {
+            mineLayer.rowNeighborCounts(r, rowCounts.data());
+            uint8_t *row = &cells[index(r, 0)];
+            for (int c = 0; c < cols; ++c) row[c] = (row[c] & ~CountMask) | rowCounts[c];
+        }
+    }
+
+    // The padded grid as stored, (rows + 2) * stride bytes
+    const uint8_t *data() const { return cells.data(); }
+    size_t byteSize() const { return cells.size(); }
+
+    // Overwrite the padded grid with byteSize() bytes, e.g. from a saved
+    // game, and rebuild the mine layer from the mine bits
+    void assignCells(const uint8_t *raw) {
+        copy(raw, raw + cells.size(), cells.begin());
+        fillBorder();
+        for (int r = 0; r < rows; ++r) mineLayer.setRowFromBytes(r, &cells[index(r, 0)], MineShift);
+    }
+
+    int countMines() const { return mineLayer.count(); }
+
+    // Call f(idx) for every mine, in row-major order, from the bit layer
+    template <class F>
+    void forEachMine(F f) const {
+        mineLayer.forEachSet([&](int row, int col) { f(index(row, col)); });
+    }
+
+    // Full scans; the engine keeps these as running counters instead
+    int countFlagged() const {
+        int total = 0;
+        for (uint8_t cell : cells) total += (cell & FlaggedBit) != 0;
+        return total;
+    }
+
+    int countHiddenSafe() const {
+        int total = 0;
+        for (uint8_t cell : cells) total += (cell & (MineBit | RevealedBit)) == 0;
+        return total;
+    }
+
+    Cell at(int row, int col) const {
+        int idx = index(row, col);
+        Cell cell;
+        cell.mine = isMine(idx);
+        cell.revealed = isRevealed(idx);
+        cell.flagged = isFlagged(idx);
+        cell.adjacentMines = adjacentMines(idx);
+        return cell;
+    }
+
+    // Collect the indices of the up to 8 cells around (row, col)
+    void neighbors(int row, int col, vector<int> &out) const {
+        out.clear();
+        int idx = index(row, col);
+        for (int offset : offsets) {
+            if (!isBorder(idx + offset)) out.push_back(idx + offset);
+        }
+    }
+};
+
+#endif //BOARD_H
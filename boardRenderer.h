@@ -0,0 +1,236 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <SFML/Graphics.hpp>
+#include "board.h"
+#include "assetManager.h"
+using namespace std;
+
+// Draws the visible part of the board as one vertex array of textured
+// quads. Every tile look (base plus any flag/mine/number overlay) is
+// pre-composed into a single atlas slot at load time, so each cell is
+// exactly one quad. Only cells inside the visible range get vertices, so
+// memory and draw cost follow the viewport, not the board size; within
+// the range only the quads of changed cells are rewritten.
+class BoardRenderer {
+public:
+    enum Slot {
+        Hidden,
+        Revealed,
+        HiddenFlag,
+        RevealedMine,
+        RevealedFlagMine,  // Flagged mine uncovered after a loss
+        HiddenMine,        // Debug view of a hidden mine
+        HiddenFlagMine,    // Debug view of a flagged mine
+        Number1,           // Number1..Number8 are consecutive
+        SlotCount = Number1 + 8
+    };
+
+private:
+    int tileSize;
+    bool debugMode = false;
+
+    // Visible cell range [rowBegin, rowEnd) x [colBegin, colEnd)
+    int rowBegin = 0, rowEnd = 0;
+    int colBegin = 0, colEnd = 0;
+    sf::Texture atlas;
+    sf::VertexArray vertices;
+
+    // While covered (paused) the board is one quad tiled with the revealed
+    // tile; the tile quads stay as they are
+    bool covered = false;
+    sf::Texture coverTexture;
+
+    // Optional tint over hidden cells, green for safe through red for a mine
+    const Board *overlayBoard = nullptr;
+    const vector<float> *overlayValues = nullptr;
+    sf::VertexArray overlay;
+
+    // Copy base into a slot and alpha-blend the overlays on top of it
+    void compose(sf::Image &target, Slot slot, const sf::Image &base,
+                 const sf::Image *overlay = nullptr, const sf::Image *overlay2 = nullptr) {
+        int x = slot * tileSize;
+        target.copy(base, x, 0, sf::IntRect(0, 0, tileSize, tileSize));
+        if (overlay) target.copy(*overlay, x, 0, sf::IntRect(0, 0, tileSize, tileSize), true);
+        if (overlay2) target.copy(*overlay2, x, 0, sf::IntRect(0, 0, tileSize, tileSize), true);
+    }
+
+    // Cells is any grid with isMine/isRevealed/isFlagged/adjacentMines
+    // taking (row, col): a Board or an InfiniteBoard
+    template <class Cells>
+    int slotFor(const Cells &cells, int row, int col) const {
+        bool flagged = cells.isFlagged(row, col);
+        if (cells.isRevealed(row, col)) {
+            if (cells.isMine(row, col)) return flagged ? RevealedFlagMine : RevealedMine;
+            int count = cells.adjacentMines(row, col);
+            return count > 0 ? Number1 + count - 1 : Revealed;
+        }
+        if (debugMode && cells.isMine(row, col)) return flagged ? HiddenFlagMine : HiddenMine;
+        return flagged ? HiddenFlag : Hidden;
+    }
+
+    void setQuad(int row, int col, int slot) {
+        size_t local = static_cast<size_t>(row - rowBegin) * (colEnd - colBegin) + (col - colBegin);
+        sf::Vertex *quad = &vertices[local * 4];
+        float u = static_cast<float>(slot * tileSize);
+        float size = static_cast<float>(tileSize);
+        quad[0].texCoords = sf::Vector2f(u, 0);
+        quad[1].texCoords = sf::Vector2f(u + size, 0);
+        quad[2].texCoords = sf::Vector2f(u + size, size);
+        quad[3].texCoords = sf::Vector2f(u, size);
+    }
+
+public:
+    explicit BoardRenderer(int tileSize = 32) : tileSize(tileSize) {}
+
+    // Pack every tile image from imageDir into the atlas
+    void loadAtlas(AssetManager &assets, const string &imageDir) {
+        const sf::Image &hidden = assets.image(imageDir + "tile_hidden.png");
+        const sf::Image &revealed = assets.image(imageDir + "tile_revealed.png");
+        const sf::Image &flag = assets.image(imageDir + "flag.png");
+        const sf::Image &mine = assets.image(imageDir + "mine.png");
+
+        sf::Image sheet;
+        sheet.create(SlotCount * tileSize, tileSize, sf::Color::Transparent);
+        compose(sheet, Hidden, hidden);
+        compose(sheet, Revealed, revealed);
+        compose(sheet, HiddenFlag, hidden, &flag);
+        compose(sheet, RevealedMine, revealed, &mine);
+        compose(sheet, RevealedFlagMine, revealed, &flag, &mine);
+        compose(sheet, HiddenMine, hidden, &mine);
+        compose(sheet, HiddenFlagMine, hidden, &flag, &mine);
+        for (int i = 1; i <= 8; ++i) {
+            const sf::Image &number = assets.image(imageDir + "number_" + to_string(i) + ".png");
+            compose(sheet, static_cast<Slot>(Number1 + i - 1), revealed, &number);
+        }
+
+        if (!atlas.loadFromImage(sheet)) throw runtime_error("Unable to create tile atlas");
+        if (!coverTexture.loadFromImage(revealed, sf::IntRect(0, 0, tileSize, tileSize))) {
+            throw runtime_error("Unable to create cover texture");
+        }
+        coverTexture.setRepeated(true);
+    }
+
+    // Rebuild the quads for a new visible range; a no-op if unchanged
+    template <class Cells>
+    void setVisibleRange(const Cells &cells, int newRowBegin, int newRowEnd, int newColBegin, int newColEnd) {
+        if (newRowBegin == rowBegin && newRowEnd == rowEnd && newColBegin == colBegin && newColEnd == colEnd) return;
+        rowBegin = newRowBegin;
+        rowEnd = max(newRowEnd, newRowBegin);
+        colBegin = newColBegin;
+        colEnd = max(newColEnd, newColBegin);
+
+        vertices.setPrimitiveType(sf::Quads);
+        vertices.resize(static_cast<size_t>(rowEnd - rowBegin) * (colEnd - colBegin) * 4);
+
+        float size = static_cast<float>(tileSize);
+        for (int r = rowBegin; r < rowEnd; ++r) {
+            for (int c = colBegin; c < colEnd; ++c) {
+                size_t local = static_cast<size_t>(r - rowBegin) * (colEnd - colBegin) + (c - colBegin);
+                sf::Vertex *quad = &vertices[local * 4];
+                float x = c * size, y = r * size;
+                quad[0].position = sf::Vector2f(x, y);
+                quad[1].position = sf::Vector2f(x + size, y);
+                quad[2].position = sf::Vector2f(x + size, y + size);
+                quad[3].position = sf::Vector2f(x, y + size);
+            }
+        }
+        updateAll(cells);
+        updateOverlay();
+    }
+
+    bool isVisible(int row, int col) const {
+        return row >= rowBegin && row < rowEnd && col >= colBegin && col < colEnd;
+    }
+
+    // Cells outside the visible range are picked up when they scroll in
+    template <class Cells>
+    void updateCell(const Cells &cells, int row, int col) {
+        if (isVisible(row, col)) setQuad(row, col, slotFor(cells, row, col));
+    }
+
+    void updateCell(const Board &board, int idx) { updateCell(board, board.rowOf(idx), board.colOf(idx)); }
+
+    template <class Cells>
+    void updateAll(const Cells &cells) {
+        for (int r = rowBegin; r < rowEnd; ++r) {
+            for (int c = colBegin; c < colEnd; ++c) setQuad(r, c, slotFor(cells, r, c));
+        }
+    }
+
+    // Debug mode shows hidden mines; only the mine quads need rewriting
+    void setDebugMode(bool enabled, const Board &board, const vector<int> &mineCells) {
+        debugMode = enabled;
+        for (int idx : mineCells) updateCell(board, idx);
+    }
+
+    // For boards without a mine list; call updateAll afterwards
+    void setDebugMode(bool enabled) { debugMode = enabled; }
+
+    // Tint each hidden cell of board by its value in [0, 1] (indexed by cell
+    // index; negative means no tint). Both must outlive the overlay; call
+    // updateOverlay when the values change. Null values remove the overlay.
+    void setOverlay(const Board *board, const vector<float> *values) {
+        overlayBoard = board;
+        overlayValues = values;
+        updateOverlay();
+    }
+
+    void updateOverlay() {
+        overlay.setPrimitiveType(sf::Quads);
+        overlay.clear();
+        if (!overlayBoard || !overlayValues) return;
+
+        float size = static_cast<float>(tileSize);
+        for (int r = rowBegin; r < rowEnd; ++r) {
+            for (int c = colBegin; c < colEnd; ++c) {
+                int idx = overlayBoard->index(r, c);
+                float value = (*overlayValues)[idx];
+                if (value < 0 || overlayBoard->isRevealed(idx)) continue;
+                sf::Color color(static_cast<sf::Uint8>(255 * value), static_cast<sf::Uint8>(255 * (1 - value)), 0, 96);
+                float x = c * size, y = r * size;
+                overlay.append(sf::Vertex(sf::Vector2f(x, y), color));
+                overlay.append(sf::Vertex(sf::Vector2f(x + size, y), color));
+                overlay.append(sf::Vertex(sf::Vector2f(x + size, y + size), color));
+                overlay.append(sf::Vertex(sf::Vector2f(x, y + size), color));
+            }
+        }
+    }
+
+    // Switch between the board and a blank cover over the visible range.
+    // Costs nothing either way: no quad is rewritten.
+    void setCovered(bool enabled) { covered = enabled; }
+    bool isCovered() const { return covered; }
+
+    void draw(sf::RenderTarget &target) const {
+        if (covered) {
+            // Texture coordinates equal positions, so the repeated tile
+            // lines up with the cell grid
+            float left = static_cast<float>(colBegin * tileSize), top = static_cast<float>(rowBegin * tileSize);
+            float right = static_cast<float>(colEnd * tileSize), bottom = static_cast<float>(rowEnd * tileSize);
+            sf::Vertex quad[4];
+            quad[0].position = quad[0].texCoords = sf::Vector2f(left, top);
+            quad[1].position = quad[1].texCoords = sf::Vector2f(right, top);
+            quad[2].position = quad[2].texCoords = sf::Vector2f(right, bottom);
+            quad[3].position = quad[3].texCoords = sf::Vector2f(left, bottom);
+            target.draw(quad, 4, sf::Quads, sf::RenderStates(&coverTexture));
+            return;
+        }
+        target.draw(vertices, sf::RenderStates(&atlas));
+        if (overlay.getVertexCount() > 0) target.draw(overlay);
+    }
+
+    int getRowBegin() const { return rowBegin; }
+    int getRowEnd() const { return rowEnd; }
+    int getColBegin() const { return colBegin; }
+    int getColEnd() const { return colEnd; }
+
+    const sf::Texture &getAtlas() const { return atlas; }
+    sf::IntRect slotRect(Slot slot) const { return sf::IntRect(slot * tileSize, 0, tileSize, tileSize); }
+};
+
+#endif //BOARDRENDERER_H
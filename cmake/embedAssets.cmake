@@ -0,0 +1,39 @@
+## Turns the game's assets into a header of byte arrays so the binary
+## starts without reading them from disk. Run in script mode:
+##   cmake -DSOURCE_DIR=<repo> -DOUTPUT=<header> -P embedAssets.cmake
+## Every path is stored relative to SOURCE_DIR, as the game asks for it.
+## files/config.cfg is settings players edit, so it is always read from disk.
+
+set(assets files/font.ttf)
+file(GLOB images RELATIVE ${SOURCE_DIR} ${SOURCE_DIR}/files/images/*.png)
+list(SORT images)
+list(APPEND assets ${images})
+
+# CMake regexes have no {n} repeat, so spell out a line of sixteen bytes
+set(line "")
+foreach(i RANGE 15)
+    set(line "${line}0x..,")
+endforeach()
+
+set(arrays "")
+set(table "")
+set(index 0)
+foreach(asset ${assets})
+    file(READ ${SOURCE_DIR}/${asset} hex HEX)
+    string(LENGTH "${hex}" digits)
+    math(EXPR size "${digits} / 2")
+    # Sixteen bytes per line
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(REGEX REPLACE "(${line})" "\\1\n    " bytes "${bytes}")
+    set(arrays "${arrays}static const unsigned char embeddedAsset${index}[] = {\n    ${bytes}0x00};\n\n")
+    set(table "${table}    {\"${asset}\", embeddedAsset${index}, ${size}},\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+set(header "// Generated by cmake/embedAssets.cmake at build time; do not edit\n\n")
+set(header "${header}#ifndef EMBEDDEDASSETS_H\n#define EMBEDDEDASSETS_H\n\n#include <cstddef>\n\n")
+set(header "${header}struct EmbeddedAsset {\n    const char *path;\n    const unsigned char *data;\n    std::size_t size;\n};\n\n")
+set(header "${header}${arrays}static const EmbeddedAsset embeddedAssets[] = {\n${table}};\n\n")
+set(header "${header}static const std::size_t embeddedAssetCount = ${index};\n\n#endif //EMBEDDEDASSETS_H\n")
+
+file(WRITE ${OUTPUT} "${header}")
@@ -0,0 +1,147 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <algorithm>
+#include <SFML/Graphics.hpp>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+using namespace std;
+
+// CPU time used by this process so far, in seconds
+inline double processCpuSeconds() {
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) return 0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (k.QuadPart + u.QuadPart) / 1e7;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#endif
+}
+
+// Decides when a window needs to be redrawn. Windows mark themselves dirty
+// (input, board change, timer tick) and the scheduler sleeps between events
+// until a redraw is due, never drawing faster than the frame cap.
+class FrameScheduler {
+public:
+    enum Reason {
+        Input = 1,
+        Board = 2,
+        Timer = 4,
+        Heartbeat = 8
+    };
+
+private:
+    sf::Clock clock;
+    sf::Time minFrameTime;
+    sf::Time lastFrame;
+    sf::Time timedRedraw;          // When the next Timer redraw is due
+    bool timedRedrawSet = false;
+    unsigned dirty = Input;        // Always draw the first frame
+
+    // SFML 2.5 can't wait for an event with a timeout, so idle waiting
+    // polls in short sleeps. This bounds the added input latency.
+    const sf::Time pollInterval = sf::milliseconds(4);
+    // Redraw at least this often even when nothing changed
+    const sf::Time heartbeat = sf::seconds(1);
+
+    // Rolling CPU usage, sampled about once a second
+    sf::Time sampleStart;
+    double sampleCpuStart = processCpuSeconds();
+    float cpuUsage = 0;
+    unsigned long framesDrawn = 0;
+
+    void sampleCpu(sf::Time now) {
+        sf::Time wall = now - sampleStart;
+        if (wall < sf::seconds(1)) return;
+        double cpu = processCpuSeconds();
+        cpuUsage = static_cast<float>((cpu - sampleCpuStart) / wall.asSeconds() * 100.0);
+        sampleStart = now;
+        sampleCpuStart = cpu;
+    }
+
+public:
+    explicit FrameScheduler(unsigned frameCap = 60) { setFrameCap(frameCap); }
+
+    // Maximum frames per second; 0 removes the cap
+    void setFrameCap(unsigned fps) {
+        minFrameTime = fps > 0 ? sf::seconds(1.0f / fps) : sf::Time::Zero;
+    }
+
+    void markDirty(unsigned reasons = Input) { dirty |= reasons; }
+
+    // Ask for a Timer redraw after delay, keeping the earliest request
+    void redrawIn(sf::Time delay) {
+        sf::Time when = clock.getElapsedTime() + delay;
+        if (!timedRedrawSet || when < timedRedraw) timedRedraw = when;
+        timedRedrawSet = true;
+    }
+
+    // Next pending event, marking the window dirty; never blocks
+    bool pollEvent(sf::RenderWindow &window, sf::Event &event) {
+        if (!window.pollEvent(event)) return false;
+        markDirty(Input);
+        return true;
+    }
+
+    // Whether a frame should be drawn now. Fires Timer and Heartbeat
+    // redraws that have come due.
+    bool frameDue() {
+        sf::Time now = clock.getElapsedTime();
+        sampleCpu(now);
+        if (timedRedrawSet && now >= timedRedraw) {
+            timedRedrawSet = false;
+            markDirty(Timer);
+        }
+        if (now - lastFrame >= heartbeat) markDirty(Heartbeat);
+        return dirty && now >= lastFrame + minFrameTime;
+    }
+
+    // How long the caller can sleep before this window could need a frame
+    sf::Time idleTime() const {
+        sf::Time now = clock.getElapsedTime();
+        sf::Time wake = now + pollInterval;
+        if (dirty) wake = min(wake, lastFrame + minFrameTime);
+        if (timedRedrawSet) wake = min(wake, timedRedraw);
+        return wake > now ? wake - now : sf::Time::Zero;
+    }
+
+    // Block until either an event arrives (returns true with it) or a
+    // frame is due (returns false). Sleeps while there is nothing to do.
+    bool waitEvent(sf::RenderWindow &window, sf::Event &event) {
+        while (window.isOpen()) {
+            if (pollEvent(window, event)) return true;
+            if (frameDue()) return false;
+
+            // Sleep until the next thing that could need a frame
+            sf::Time idle = idleTime();
+            if (idle > sf::Time::Zero) sf::sleep(idle);
+        }
+        return false;
+    }
+
+    // Call after display() so the next frame is paced from here
+    void frameDrawn() {
+        lastFrame = clock.getElapsedTime();
+        dirty = 0;
+        framesDrawn++;
+    }
+
+    // Percent of one core used by the whole process over the last second
+    float getCpuUsage() const { return cpuUsage; }
+    unsigned long getFramesDrawn() const { return framesDrawn; }
+};
+
+#endif //FRAMESCHEDULER_H
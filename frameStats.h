@@ -0,0 +1,147 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+// Per-frame timings of the render loop and input-to-display latency.
+// Keeps a rolling window for live percentiles and, when asked to, the
+// full history for a CSV dump. Headless; the window feeds it timestamps.
+class FrameStats {
+public:
+    typedef chrono::steady_clock Clock;
+
+    enum Phase { Events, Update, Draw, Display, PhaseCount };
+
+    struct Summary {
+        double p50 = 0, p99 = 0, max = 0; // Milliseconds
+        size_t samples = 0;
+    };
+
+private:
+    struct FrameRecord {
+        double at;                  // Seconds since start, at display end
+        double phases[PhaseCount];  // Milliseconds
+    };
+
+    struct LatencyRecord {
+        double at;       // Seconds since start, when the event was dequeued
+        double millis;   // Until the end of the display that showed it
+    };
+
+    static const size_t window = 240; // Frames and events in the rolling view
+
+    Clock::time_point origin = Clock::now();
+    Clock::time_point phaseStart = origin;
+    double current[PhaseCount] = {};
+
+    vector<double> recentPhases[PhaseCount];
+    vector<double> recentFrames;
+    vector<double> recentLatency;
+    size_t framePos = 0, latencyPos = 0;
+
+    vector<Clock::time_point> pendingInput; // Dequeued, not yet displayed
+
+    bool keepHistory = false;
+    vector<FrameRecord> frameHistory;
+    vector<LatencyRecord> latencyHistory;
+
+    static double millis(Clock::time_point from, Clock::time_point to) {
+        return chrono::duration<double, milli>(to - from).count();
+    }
+
+    static void push(vector<double> &ring, size_t &pos, double value) {
+        if (ring.size() < window) ring.push_back(value);
+        else ring[pos] = value;
+        pos = (pos + 1) % window;
+    }
+
+    static Summary summarize(vector<double> values) {
+        Summary summary;
+        summary.samples = values.size();
+        if (values.empty()) return summary;
+        sort(values.begin(), values.end());
+        summary.p50 = values[(values.size() - 1) / 2];
+        summary.p99 = values[(values.size() - 1) * 99 / 100];
+        summary.max = values.back();
+        return summary;
+    }
+
+public:
+    // Keep every frame and latency sample for writeCsv
+    void setKeepHistory(bool enabled) { keepHistory = enabled; }
+
+    // Phases are timed back to back: begin starts the clock for a phase,
+    // end adds the time since begin to it
+    void begin() { phaseStart = Clock::now(); }
+    void end(Phase phase) { current[phase] += millis(phaseStart, Clock::now()); }
+
+    // An input event was just taken off the queue
+    void inputDequeued() { pendingInput.push_back(Clock::now()); }
+
+    // Call right after display(): closes the frame and the latency of
+    // every input it is the first to show
+    void frameDisplayed() {
+        Clock::time_point now = Clock::now();
+        double at = chrono::duration<double>(now - origin).count();
+
+        // The phase rings and the frame ring advance together
+        double total = 0;
+        for (int p = 0; p < PhaseCount; ++p) {
+            size_t pos = framePos;
+            push(recentPhases[p], pos, current[p]);
+            total += current[p];
+        }
+        push(recentFrames, framePos, total);
+        if (keepHistory) {
+            FrameRecord record{at, {}};
+            copy(current, current + PhaseCount, record.phases);
+            frameHistory.push_back(record);
+        }
+        fill(current, current + PhaseCount, 0.0);
+
+        for (Clock::time_point dequeued : pendingInput) {
+            double latency = millis(dequeued, now);
+            push(recentLatency, latencyPos, latency);
+            if (keepHistory) latencyHistory.push_back({chrono::duration<double>(dequeued - origin).count(), latency});
+        }
+        pendingInput.clear();
+    }
+
+    // Rolling statistics over the last frames or input events
+    Summary frameSummary() const { return summarize(recentFrames); }
+    Summary phaseSummary(Phase phase) const { return summarize(recentPhases[phase]); }
+    Summary latencySummary() const { return summarize(recentLatency); }
+
+    static const char *phaseName(Phase phase) {
+        static const char *names[PhaseCount] = {"events", "update", "draw", "display"};
+        return names[phase];
+    }
+
+    // One row per frame, then one per input event; false if the file
+    // can't be written
+    bool writeCsv(const string &path) const {
+        ofstream out(path, ios::trunc);
+        if (!out) return false;
+        out << "kind,time_s,events_ms,update_ms,draw_ms,display_ms,total_ms\n";
+        char line[160];
+        for (const FrameRecord &record : frameHistory) {
+            const double *p = record.phases;
+            snprintf(line, sizeof(line), "frame,%.6f,%.4f,%.4f,%.4f,%.4f,%.4f\n", record.at,
+                     p[Events], p[Update], p[Draw], p[Display], p[Events] + p[Update] + p[Draw] + p[Display]);
+            out << line;
+        }
+        for (const LatencyRecord &record : latencyHistory) {
+            snprintf(line, sizeof(line), "input,%.6f,,,,,%.4f\n", record.at, record.millis);
+            out << line;
+        }
+        return static_cast<bool>(out);
+    }
+};
+
+#endif //FRAMESTATS_H
@@ -0,0 +1,319 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "board.h"
+#include "rng.h"
+#include "minePlacer.h"
+using namespace std;
+
+enum class GameState { Playing, Won, Lost };
+
+// Headless minesweeper rules. Knows nothing about windows or textures;
+// views query the board state and subscribe to win/loss events.
+class GameEngine {
+private:
+    Board board;
+    int mines = 0;
+    GameState state = GameState::Playing;
+
+    FastRng seeder{FastRng::randomSeed()}; // Hands out a seed per game
+    uint64_t seed = 0;                      // Seed of the current board
+    bool firstClickSafe = false;            // Defer mines until the first reveal
+    bool minesPlaced = false;
+
+    // Incremental counters so no action has to rescan the board
+    vector<int> mineCells;   // Every mine, filled at placement
+    int hiddenSafe = 0;      // Safe cells still hidden; 0 means won
+    int flagsPlaced = 0;
+    int correctFlags = 0;    // Flags sitting on mines
+
+    function<void()> onWin;
+    function<void()> onLoss;
+
+    // Chooses the board seed once the first click is known (no-guess mode)
+    function<uint64_t(uint64_t seed, int row, int col)> seedPicker;
+
+    vector<int> seeds;        // Span seeds for the flood fill, reused
+    vector<int> changedCells; // Cells touched by the last action
+
+    // Place mines from the board seed, keeping (row, col) safe if given
+    void placeMines(int row = -1, int col = -1) {
+        if (row >= 0 && seedPicker) seed = seedPicker(seed, row, col);
+        FastRng rng(seed);
+        mineCells.clear();
+        if (row < 0) {
+            MinePlacer::place(board, mines, rng, &mineCells);
+        } else {
+            MinePlacer::placeAvoiding(board, mines, rng, row, col, &mineCells);
+        }
+        minesPlaced = true;
+
+        // Nothing is revealed yet, but flags may already be down
+        hiddenSafe = board.size() - static_cast<int>(mineCells.size());
+        correctFlags = 0;
+        for (int idx : mineCells) {
+            if (board.isFlagged(idx)) correctFlags++;
+        }
+    }
+
+    bool checkWin() const {
+        return minesPlaced && hiddenSafe == 0;
+    }
+
+    void win() {
+        // Flag all remaining mines
+        for (int idx : mineCells) {
+            if (!board.isFlagged(idx)) {
+                board.setFlagged(idx);
+                changedCells.push_back(idx);
+            }
+        }
+        flagsPlaced += static_cast<int>(mineCells.size()) - correctFlags;
+        correctFlags = static_cast<int>(mineCells.size());
+        state = GameState::Won;
+        if (onWin) onWin();
+    }
+
+    void lose() {
+        // Reveal every mine, flagged or not
+        for (int idx : mineCells) {
+            if (!board.isRevealed(idx)) {
+                board.setRevealed(idx);
+                changedCells.push_back(idx);
+            }
+        }
+        state = GameState::Lost;
+        if (onLoss) onLoss();
+    }
+
+    void markRevealed(int idx) {
+        board.setRevealed(idx);
+        if (!board.isMine(idx)) hiddenSafe--;
+        changedCells.push_back(idx);
+    }
+
+    // Border sentinels read as revealed, so they are never hidden zeros
+    bool isHiddenZero(int idx) const {
+        return (board.raw(idx) & (Board::RevealedBit | Board::FlaggedBit | Board::CountMask)) == 0;
+    }
+
+    // Reveal idx if still hidden and unflagged; zero cells become seeds
+    // for their own span
+    void touch(int idx) {
+        if (board.raw(idx) & (Board::RevealedBit | Board::FlaggedBit)) return;
+        markRevealed(idx);
+        if (board.adjacentMines(idx) == 0) seeds.push_back(idx);
+    }
+
+    // Scanline flood fill from a safe cell. Each seed is widened into a
+    // horizontal span of zero cells, then the rows above and below are
+    // scanned once across the span plus its diagonals. Every cell reached
+    // is a neighbor of a zero cell, so no mine is ever opened. Runs in
+    // O(revealed cells) and reuses the seed stack between calls. The
+    // sentinel border makes every step a plain index offset.
+    void floodReveal(int start) {
+        int stride = board.getStride();
+        seeds.clear();
+        touch(start);
+
+        while (!seeds.empty()) {
+            int spanSeed = seeds.back();
+            seeds.pop_back();
+
+            int left = spanSeed, right = spanSeed;
+            while (isHiddenZero(left - 1)) markRevealed(--left);
+            while (isHiddenZero(right + 1)) markRevealed(++right);
+
+            touch(left - 1);
+            touch(right + 1);
+            for (int i = left - 1; i <= right + 1; ++i) {
+                touch(i - stride);
+                touch(i + stride);
+            }
+        }
+    }
+
+    // Reveal one cell without clearing the change list
+    bool revealCell(int row, int col) {
+        int idx = board.index(row, col);
+        if (board.isFlagged(idx) || board.isRevealed(idx)) return false;
+        if (!minesPlaced) placeMines(row, col);
+
+        if (board.isMine(idx)) {
+            markRevealed(idx);
+            lose();
+            return true;
+        }
+
+        floodReveal(idx);
+        return true;
+    }
+
+public:
+    GameEngine() {}
+    GameEngine(int cols, int rows, int mines) { configure(cols, rows, mines); }
+
+    void configure(int cols, int rows, int mineCount) {
+        if (cols <= 0 || rows <= 0) throw invalid_argument("Board must have at least one cell");
+        if (mineCount < 0 || mineCount > cols * rows) throw invalid_argument("Invalid mine count");
+        board.resize(cols, rows);
+        mines = mineCount;
+        reset();
+    }
+
+    // Start a new game with a fresh seed
+    void reset() { reset(seeder.next()); }
+
+    // Start a new game whose mine layout is fully determined by boardSeed
+    // (and, in first-click-safe mode, by where the first click lands)
+    void reset(uint64_t boardSeed) {
+        board.clear();
+        changedCells.clear();
+        mineCells.clear();
+        state = GameState::Playing;
+        seed = boardSeed;
+        minesPlaced = false;
+        hiddenSafe = board.size() - mines;
+        flagsPlaced = 0;
+        correctFlags = 0;
+        if (!firstClickSafe) placeMines();
+    }
+
+    // Resume a saved game from the raw padded grid (Board::data of the
+    // same size). The counters and the state are rebuilt from the cells.
+    void restore(int cols, int rows, int mineCount, uint64_t boardSeed, bool safeFirstClick, bool placed,
+                 const uint8_t *cells) {
+        if (cols <= 0 || rows <= 0) throw invalid_argument("Board must have at least one cell");
+        if (mineCount < 0 || mineCount > cols * rows) throw invalid_argument("Invalid mine count");
+        board.resize(cols, rows);
+        board.assignCells(cells);
+        mines = mineCount;
+        seed = boardSeed;
+        firstClickSafe = safeFirstClick;
+        minesPlaced = placed;
+        changedCells.clear();
+
+        // Counters in one branch-free pass over each row; the mines come
+        // from the board's bit layer
+        const uint8_t both = Board::MineBit | Board::RevealedBit;
+        const uint8_t flaggedMine = Board::MineBit | Board::FlaggedBit;
+        int hidden = 0, flags = 0, correct = 0, minesRevealed = 0;
+        for (int r = 0; r < rows; ++r) {
+            const uint8_t *row = board.data() + board.index(r, 0);
+            for (int c = 0; c < cols; ++c) {
+                uint8_t cell = row[c];
+                hidden += (cell & both) == 0;
+                flags += (cell & Board::FlaggedBit) != 0;
+                correct += (cell & flaggedMine) == flaggedMine;
+                minesRevealed += (cell & both) == both;
+            }
+        }
+        mineCells.clear();
+        mineCells.reserve(placed ? mines : 0);
+        board.forEachMine([this](int idx) { mineCells.push_back(idx); });
+        if (static_cast<int>(mineCells.size()) != (placed ? mines : 0)) {
+            throw invalid_argument("Saved board doesn't hold the mine count");
+        }
+        hiddenSafe = hidden;
+        flagsPlaced = flags;
+        correctFlags = correct;
+        if (!minesPlaced) hiddenSafe = board.size() - mines;
+        state = minesRevealed > 0 ? GameState::Lost : checkWin() ? GameState::Won : GameState::Playing;
+    }
+
+    // Takes effect from the next reset
+    void setFirstClickSafe(bool enabled) { firstClickSafe = enabled; }
+    bool isFirstClickSafe() const { return firstClickSafe; }
+    uint64_t getSeed() const { return seed; }
+    bool areMinesPlaced() const { return minesPlaced; }
+
+    void setWinHandler(function<void()> handler) { onWin = handler; }
+    void setLossHandler(function<void()> handler) { onLoss = handler; }
+
+    // In first-click-safe mode, let picker replace the board seed when the
+    // first click lands. getSeed then returns the seed actually used, so
+    // reset(getSeed()) plus the same first click rebuilds the board.
+    void setSeedPicker(function<uint64_t(uint64_t seed, int row, int col)> picker) { seedPicker = picker; }
+
+    // Reveal a cell; returns true if anything changed
+    bool reveal(int row, int col) {
+        if (state != GameState::Playing || !board.inBounds(row, col)) return false;
+        changedCells.clear();
+        if (!revealCell(row, col)) return false;
+
+        if (state == GameState::Playing && checkWin()) win();
+        return true;
+    }
+
+    // Toggle a flag on a hidden cell; returns true if it changed
+    bool flag(int row, int col) {
+        if (state != GameState::Playing || !board.inBounds(row, col)) return false;
+        int idx = board.index(row, col);
+        if (board.isRevealed(idx)) return false;
+
+        bool flagged = !board.isFlagged(idx);
+        board.setFlagged(idx, flagged);
+        int delta = flagged ? 1 : -1;
+        flagsPlaced += delta;
+        if (board.isMine(idx)) correctFlags += delta;
+        changedCells.assign(1, idx);
+        return true;
+    }
+
+    // Reveal the unflagged neighbors of a number whose flags are all placed
+    bool chord(int row, int col) {
+        if (state != GameState::Playing || !board.inBounds(row, col)) return false;
+        int idx = board.index(row, col);
+        if (!board.isRevealed(idx) || board.adjacentMines(idx) == 0) return false;
+
+        vector<int> around;
+        board.neighbors(row, col, around);
+        int flags = 0;
+        for (int n : around) {
+            if (board.isFlagged(n)) flags++;
+        }
+        if (flags != board.adjacentMines(idx)) return false;
+
+        changedCells.clear();
+        bool changed = false;
+        for (int n : around) {
+            if (state != GameState::Playing) break;
+            changed |= revealCell(board.rowOf(n), board.colOf(n));
+        }
+
+        if (changed && state == GameState::Playing && checkWin()) win();
+        return changed;
+    }
+
+    // State queries
+    GameState getState() const { return state; }
+    bool isGameOver() const { return state != GameState::Playing; }
+    bool hasWon() const { return state == GameState::Won; }
+    bool hasLost() const { return state == GameState::Lost; }
+
+    int getCols() const { return board.getCols(); }
+    int getRows() const { return board.getRows(); }
+    int getMines() const { return mines; }
+    int getFlagsPlaced() const { return flagsPlaced; }
+    int getRemainingMines() const { return mines - flagsPlaced; }
+    int getHiddenSafeCells() const { return hiddenSafe; }
+    int getCorrectFlags() const { return correctFlags; }
+    const vector<int> &getMineCells() const { return mineCells; }
+
+    bool isMine(int row, int col) const { return board.isMine(board.index(row, col)); }
+    bool isRevealed(int row, int col) const { return board.isRevealed(board.index(row, col)); }
+    bool isFlagged(int row, int col) const { return board.isFlagged(board.index(row, col)); }
+    int getAdjacentMines(int row, int col) const { return board.adjacentMines(board.index(row, col)); }
+
+    // Indices of every cell revealed, flagged or unflagged by the last
+    // reveal/flag/chord, for views that redraw only what changed
+    const vector<int> &getChangedCells() const { return changedCells; }
+
+    const Board &getBoard() const { return board; }
+};
+
+#endif //GAMEENGINE_H
@@ -0,0 +1,330 @@
+#ifndef INFINITEENGINE_H
+#define INFINITEENGINE_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include "board.h"
+#include "rng.h"
+#include "minePlacer.h"
+#include "gameEngine.h"
+using namespace std;
+
+struct CellPos {
+    int row;
+    int col;
+};
+
+// Unbounded board stored as fixed-size chunks in a hash map. A chunk's
+// mines come from a seed derived from the world seed and the chunk's
+// coordinates, so any chunk can be regenerated identically at any time:
+// neighbor counts across chunk borders stay consistent, and chunks nobody
+// has revealed or flagged in can be dropped and rebuilt later.
+class InfiniteBoard {
+public:
+    static const int chunkSize = 32;
+
+private:
+    struct Chunk {
+        Board cells{chunkSize, chunkSize}; // Mines, revealed and flagged bits
+        int touchedCells = 0;              // Revealed plus flagged cells
+    };
+
+    uint64_t worldSeed = 0;
+    int minesPerChunk = 0;
+
+    // The first click's 3x3 block is kept free of mines
+    bool hasSafeZone = false;
+    int safeRow = 0, safeCol = 0;
+
+    // Generation is deterministic, so lookups may fill the cache from
+    // const methods
+    mutable unordered_map<uint64_t, Chunk> chunks;
+    mutable uint64_t lastKey = 0;
+    mutable Chunk *lastChunk = nullptr;
+
+    static int floorDiv(int value) {
+        return value >= 0 ? value / chunkSize : -((-value + chunkSize - 1) / chunkSize);
+    }
+
+    static uint64_t keyOf(int chunkRow, int chunkCol) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32) | static_cast<uint32_t>(chunkCol);
+    }
+
+    Chunk &chunkAt(int row, int col, int &localIdx) const {
+        int chunkRow = floorDiv(row), chunkCol = floorDiv(col);
+        int localRow = row - chunkRow * chunkSize, localCol = col - chunkCol * chunkSize;
+
+        uint64_t key = keyOf(chunkRow, chunkCol);
+        if (lastChunk && key == lastKey) {
+            localIdx = lastChunk->cells.index(localRow, localCol);
+            return *lastChunk;
+        }
+
+        auto found = chunks.find(key);
+        if (found == chunks.end()) {
+            found = chunks.emplace(key, Chunk()).first;
+            FastRng rng(worldSeed ^ (key * 0x9E3779B97F4A7C15ULL));
+            MinePlacer::place(found->second.cells, minesPerChunk, rng);
+        }
+        lastKey = key;
+        lastChunk = &found->second;
+        localIdx = lastChunk->cells.index(localRow, localCol);
+        return found->second;
+    }
+
+    void touch(Chunk &chunk, int delta) { chunk.touchedCells += delta; }
+
+public:
+    void reset(uint64_t seed, double density) {
+        worldSeed = seed;
+        minesPerChunk = static_cast<int>(lround(density * chunkSize * chunkSize));
+        hasSafeZone = false;
+        chunks.clear();
+        lastChunk = nullptr;
+    }
+
+    void setSafeZone(int row, int col) {
+        hasSafeZone = true;
+        safeRow = row;
+        safeCol = col;
+    }
+
+    bool isMine(int row, int col) const {
+        if (hasSafeZone && abs(row - safeRow) <= 1 && abs(col - safeCol) <= 1) return false;
+        int idx;
+        return chunkAt(row, col, idx).cells.isMine(idx);
+    }
+
+    bool isRevealed(int row, int col) const {
+        int idx;
+        return chunkAt(row, col, idx).cells.isRevealed(idx);
+    }
+
+    bool isFlagged(int row, int col) const {
+        int idx;
+        return chunkAt(row, col, idx).cells.isFlagged(idx);
+    }
+
+    // Counted on demand so chunk borders need no stitching
+    int adjacentMines(int row, int col) const {
+        int count = 0;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if ((dr || dc) && isMine(row + dr, col + dc)) count++;
+            }
+        }
+        return count;
+    }
+
+    void setRevealed(int row, int col) {
+        int idx;
+        Chunk &chunk = chunkAt(row, col, idx);
+        if (chunk.cells.isRevealed(idx)) return;
+        chunk.cells.setRevealed(idx);
+        touch(chunk, chunk.cells.isFlagged(idx) ? 0 : 1);
+    }
+
+    void setFlagged(int row, int col, bool value) {
+        int idx;
+        Chunk &chunk = chunkAt(row, col, idx);
+        if (chunk.cells.isFlagged(idx) == value) return;
+        chunk.cells.setFlagged(idx, value);
+        if (!chunk.cells.isRevealed(idx)) touch(chunk, value ? 1 : -1);
+    }
+
+    // Drop every chunk with no revealed or flagged cells; they are rebuilt
+    // from their seed if needed again. Returns how many were dropped.
+    size_t evictUntouched() {
+        size_t before = chunks.size();
+        for (auto it = chunks.begin(); it != chunks.end();) {
+            if (it->second.touchedCells == 0) it = chunks.erase(it);
+            else ++it;
+        }
+        lastChunk = nullptr;
+        return before - chunks.size();
+    }
+
+    // Uncover every mine in the loaded chunks (used after a loss)
+    void revealLoadedMines(vector<CellPos> &changed) {
+        for (auto &entry : chunks) {
+            int chunkRow = static_cast<int32_t>(entry.first >> 32);
+            int chunkCol = static_cast<int32_t>(entry.first & 0xFFFFFFFFu);
+            Board &cells = entry.second.cells;
+            for (int n = 0; n < cells.size(); ++n) {
+                int i = cells.indexOfNth(n);
+                int row = chunkRow * chunkSize + cells.rowOf(i);
+                int col = chunkCol * chunkSize + cells.colOf(i);
+                if (cells.isRevealed(i) || !isMine(row, col)) continue;
+                cells.setRevealed(i);
+                if (!cells.isFlagged(i)) entry.second.touchedCells++;
+                changed.push_back({row, col});
+            }
+        }
+    }
+
+    size_t getChunkCount() const { return chunks.size(); }
+};
+
+// Rules for the infinite board: reveal, flag and chord like GameEngine,
+// but there is no last safe cell, so the game only ends on a mine.
+class InfiniteEngine {
+private:
+    InfiniteBoard board;
+    double density = 0.15;
+    uint64_t seed = 0;
+    FastRng seeder{FastRng::randomSeed()};
+    GameState state = GameState::Playing;
+    bool started = false;
+
+    long long revealedCells = 0;
+    int flagsPlaced = 0;
+    size_t evictThreshold = 1024; // Chunk count that triggers eviction
+
+    vector<CellPos> seeds;        // Flood fill stack, reused
+    vector<CellPos> changedCells; // Cells touched by the last action
+
+    function<void()> onLoss;
+
+    void markRevealed(int row, int col) {
+        board.setRevealed(row, col);
+        revealedCells++;
+        changedCells.push_back({row, col});
+    }
+
+    // Depth-first fill over zero cells. Crosses chunk borders freely;
+    // every cell reached is a neighbor of a zero cell, so never a mine.
+    void floodReveal(int row, int col) {
+        seeds.clear();
+        markRevealed(row, col);
+        if (board.adjacentMines(row, col) == 0) seeds.push_back({row, col});
+
+        while (!seeds.empty()) {
+            CellPos current = seeds.back();
+            seeds.pop_back();
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    int nr = current.row + dr, nc = current.col + dc;
+                    if ((!dr && !dc) || board.isRevealed(nr, nc) || board.isFlagged(nr, nc)) continue;
+                    markRevealed(nr, nc);
+                    if (board.adjacentMines(nr, nc) == 0) seeds.push_back({nr, nc});
+                }
+            }
+        }
+    }
+
+    bool revealCell(int row, int col) {
+        if (board.isFlagged(row, col) || board.isRevealed(row, col)) return false;
+        if (!started) {
+            board.setSafeZone(row, col);
+            started = true;
+        }
+
+        if (board.isMine(row, col)) {
+            markRevealed(row, col);
+            board.revealLoadedMines(changedCells);
+            state = GameState::Lost;
+            if (onLoss) onLoss();
+            return true;
+        }
+
+        floodReveal(row, col);
+        return true;
+    }
+
+    // Keep memory proportional to the explored area
+    void maybeEvict() {
+        if (board.getChunkCount() < evictThreshold) return;
+        board.evictUntouched();
+        evictThreshold = max<size_t>(1024, board.getChunkCount() * 2);
+    }
+
+public:
+    // density is the fraction of cells holding mines. A cell is zero when
+    // it and its 8 neighbors are mine-free, (1 - density)^9 of cells; at
+    // 10% that is about 39%, the percolation threshold of 8-connected
+    // sites, where one click can open an unbounded region. 15% (about 23%
+    // zeros) keeps every opening finite and small.
+    void configure(double mineDensity) {
+        if (mineDensity < 0.15 || mineDensity > 0.9) throw invalid_argument("Infinite mode needs a mine density between 15% and 90%");
+        density = mineDensity;
+        reset();
+    }
+
+    void reset() { reset(seeder.next()); }
+
+    void reset(uint64_t worldSeed) {
+        seed = worldSeed;
+        board.reset(seed, density);
+        state = GameState::Playing;
+        started = false;
+        revealedCells = 0;
+        flagsPlaced = 0;
+        evictThreshold = 1024;
+        changedCells.clear();
+    }
+
+    void setLossHandler(function<void()> handler) { onLoss = handler; }
+
+    bool reveal(int row, int col) {
+        if (state != GameState::Playing) return false;
+        changedCells.clear();
+        bool changed = revealCell(row, col);
+        maybeEvict();
+        return changed;
+    }
+
+    bool flag(int row, int col) {
+        if (state != GameState::Playing || board.isRevealed(row, col)) return false;
+        bool flagged = !board.isFlagged(row, col);
+        board.setFlagged(row, col, flagged);
+        flagsPlaced += flagged ? 1 : -1;
+        changedCells.assign(1, CellPos{row, col});
+        maybeEvict();
+        return true;
+    }
+
+    bool chord(int row, int col) {
+        if (state != GameState::Playing || !board.isRevealed(row, col)) return false;
+        int count = board.adjacentMines(row, col);
+        if (count == 0) return false;
+
+        int flags = 0;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if ((dr || dc) && board.isFlagged(row + dr, col + dc)) flags++;
+            }
+        }
+        if (flags != count) return false;
+
+        changedCells.clear();
+        bool changed = false;
+        for (int dr = -1; dr <= 1 && state == GameState::Playing; ++dr) {
+            for (int dc = -1; dc <= 1 && state == GameState::Playing; ++dc) {
+                if (dr || dc) changed |= revealCell(row + dr, col + dc);
+            }
+        }
+        maybeEvict();
+        return changed;
+    }
+
+    GameState getState() const { return state; }
+    bool isGameOver() const { return state != GameState::Playing; }
+    bool hasLost() const { return state == GameState::Lost; }
+    uint64_t getSeed() const { return seed; }
+    double getDensity() const { return density; }
+    long long getRevealedCells() const { return revealedCells; }
+    int getFlagsPlaced() const { return flagsPlaced; }
+    size_t getChunkCount() const { return board.getChunkCount(); }
+
+    const vector<CellPos> &getChangedCells() const { return changedCells; }
+    const InfiniteBoard &getBoard() const { return board; }
+    InfiniteBoard &getBoard() { return board; }
+};
+
+#endif //INFINITEENGINE_H
@@ -0,0 +1,269 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "atomicFile.h"
+using namespace std;
+
+struct LeaderboardEntry {
+    int cols = 0, rows = 0, mines = 0; // The board the time was set on
+    uint32_t millis = 0;
+    string name;
+
+    bool sameBoard(int c, int r, int m) const { return cols == c && rows == r && mines == m; }
+};
+
+// Best time per player for every board configuration, one
+// "cols,rows,mines,millis,name" line per entry. Files are mapped and parsed
+// in place without allocating (short names fit std::string's inline
+// buffer), and saved atomically so a crash leaves the old file intact.
+// Headless so tools and benchmarks can use it without a window.
+class Leaderboard {
+public:
+    static const size_t tableSize = 5; // Entries shown per board
+
+private:
+    string path;
+    int cols = 0, rows = 0, mines = 0;  // The board getEntries and addScore use
+    vector<LeaderboardEntry> entries;   // Every board, sorted by board then time
+    vector<LeaderboardEntry> table;     // Top of the current board
+    size_t skippedLines = 0;
+
+    static bool boardLess(const LeaderboardEntry &a, const LeaderboardEntry &b) {
+        if (a.cols != b.cols) return a.cols < b.cols;
+        if (a.rows != b.rows) return a.rows < b.rows;
+        if (a.mines != b.mines) return a.mines < b.mines;
+        return a.millis < b.millis;
+    }
+
+    // Unsigned decimal at p, stopping at the first non-digit; false if
+    // there are no digits or the value overflows 32 bits
+    static bool parseNumber(const char *&p, const char *end, uint32_t &value) {
+        const char *start = p;
+        uint64_t total = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            total = total * 10 + static_cast<uint64_t>(*p++ - '0');
+            if (total > UINT32_MAX) return false;
+        }
+        value = static_cast<uint32_t>(total);
+        return p != start;
+    }
+
+    static bool expect(const char *&p, const char *end, char c) {
+        if (p == end || *p != c) return false;
+        ++p;
+        return true;
+    }
+
+    // One line without its newline. Either the current format or the old
+    // "MM:SS,name" one, which is credited to the current board.
+    bool parseLine(const char *p, const char *end, LeaderboardEntry &entry) const {
+        uint32_t first, second;
+        if (!parseNumber(p, end, first)) return false;
+        if (expect(p, end, ':')) {
+            if (!parseNumber(p, end, second) || second >= 60 || !expect(p, end, ',')) return false;
+            uint64_t millis = (static_cast<uint64_t>(first) * 60 + second) * 1000;
+            if (millis > UINT32_MAX) return false;
+            entry.cols = cols;
+            entry.rows = rows;
+            entry.mines = mines;
+            entry.millis = static_cast<uint32_t>(millis);
+            if (p < end && *p == ' ') ++p; // Old files wrote ", name"
+        } else {
+            uint32_t fields[4] = {first};
+            for (int i = 1; i < 4; ++i) {
+                if (!expect(p, end, ',') || !parseNumber(p, end, fields[i])) return false;
+            }
+            if (!expect(p, end, ',') || fields[0] == 0 || fields[1] == 0 || fields[0] > INT32_MAX ||
+                fields[1] > INT32_MAX || fields[2] > INT32_MAX) {
+                return false;
+            }
+            entry.cols = static_cast<int>(fields[0]);
+            entry.rows = static_cast<int>(fields[1]);
+            entry.mines = static_cast<int>(fields[2]);
+            entry.millis = fields[3];
+        }
+        if (p == end) return false; // No name
+        entry.name.assign(p, end);
+        return true;
+    }
+
+    static size_t boardNameHash(const LeaderboardEntry &entry) {
+        size_t seed = hash<string>()(entry.name);
+        for (int value : {entry.cols, entry.rows, entry.mines}) {
+            seed ^= static_cast<size_t>(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+
+    // Keep each player's best time per board in one pass. Entries must be
+    // in board then time order, so the first one seen is the best. Kept
+    // entries are indexed in an open-addressed table that stays under half
+    // full, so there is no allocation per entry.
+    void removeSlowerDuplicates() {
+        size_t capacity = 16;
+        while (capacity < entries.size() * 2) capacity <<= 1;
+        vector<size_t> slots(capacity, 0); // Index of a kept entry plus one; 0 is empty
+        size_t kept = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i != kept) entries[kept] = move(entries[i]);
+            const LeaderboardEntry &entry = entries[kept];
+            size_t slot = boardNameHash(entry) & (capacity - 1);
+            bool duplicate = false;
+            for (; slots[slot] != 0; slot = (slot + 1) & (capacity - 1)) {
+                const LeaderboardEntry &other = entries[slots[slot] - 1];
+                if (other.sameBoard(entry.cols, entry.rows, entry.mines) && other.name == entry.name) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) slots[slot] = ++kept;
+        }
+        entries.erase(entries.begin() + static_cast<ptrdiff_t>(kept), entries.end());
+    }
+
+    void rebuildTable() {
+        table.clear();
+        LeaderboardEntry first;
+        first.cols = cols;
+        first.rows = rows;
+        first.mines = mines;
+        auto it = lower_bound(entries.begin(), entries.end(), first, boardLess);
+        for (; it != entries.end() && it->sameBoard(cols, rows, mines) && table.size() < tableSize; ++it) {
+            table.push_back(*it);
+        }
+    }
+
+public:
+    explicit Leaderboard(const string &path = "files/leaderboard.txt") : path(path) {}
+
+    // Choose the board whose table getEntries shows and addScore updates
+    void setBoard(int boardCols, int boardRows, int boardMines) {
+        cols = boardCols;
+        rows = boardRows;
+        mines = boardMines;
+        rebuildTable();
+    }
+
+    // Replace the entries with the file's. Malformed lines are skipped and
+    // counted; returns false if the file can't be opened.
+    bool load() {
+        entries.clear();
+        table.clear();
+        skippedLines = 0;
+        MappedFile file;
+        if (!file.open(path)) {
+            cerr << "Error: Could not open leaderboard file.\n";
+            return false;
+        }
+
+        const char *p = reinterpret_cast<const char *>(file.data());
+        const char *end = p + file.size();
+        entries.reserve(static_cast<size_t>(count(p, end, '\n')) + 1);
+        LeaderboardEntry entry;
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!lineEnd) lineEnd = end;
+            const char *trimmed = lineEnd;
+            if (trimmed > p && trimmed[-1] == '\r') --trimmed;
+            if (trimmed > p && *p != '#') {
+                if (parseLine(p, trimmed, entry)) {
+                    entries.push_back(move(entry));
+                } else {
+                    skippedLines++;
+                }
+            }
+            p = lineEnd + 1;
+        }
+        if (skippedLines > 0) cerr << "Warning: skipped " << skippedLines << " malformed leaderboard lines\n";
+
+        // save writes board then time order, so only hand-edited or old
+        // files need sorting; duplicates cost one lookup per entry
+        if (!is_sorted(entries.begin(), entries.end(), boardLess)) {
+            stable_sort(entries.begin(), entries.end(), boardLess);
+        }
+        removeSlowerDuplicates();
+        rebuildTable();
+        return true;
+    }
+
+    // Write every entry to a temporary file and rename it over the old
+    // one; false (and the old file untouched) on failure
+    bool save() const {
+        string text = "# cols,rows,mines,millis,name\n";
+        text.reserve(text.size() + entries.size() * 32);
+        char line[64];
+        for (const LeaderboardEntry &entry : entries) {
+            snprintf(line, sizeof(line), "%d,%d,%d,%u,", entry.cols, entry.rows, entry.mines,
+                     static_cast<unsigned>(entry.millis));
+            text += line;
+            text += entry.name;
+            text += '\n';
+        }
+        try {
+            writeFileAtomically(path, text.data(), text.size());
+        } catch (const runtime_error &e) {
+            cerr << "Error: Could not write leaderboard file: " << e.what() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Record a finished game on the current board in memory, keeping the
+    // player's best time; returns true if the entries changed
+    bool record(const string &playerName, uint32_t millis) {
+        auto it = find_if(entries.begin(), entries.end(), [&](const LeaderboardEntry &entry) {
+            return entry.sameBoard(cols, rows, mines) && entry.name == playerName;
+        });
+        if (it != entries.end() && millis >= it->millis) return false;
+
+        LeaderboardEntry entry;
+        if (it == entries.end()) {
+            entry.cols = cols;
+            entry.rows = rows;
+            entry.mines = mines;
+            entry.name = playerName;
+        } else {
+            // Only a better time moves the entry, and only up its board
+            entry = *it;
+            entries.erase(it);
+        }
+        entry.millis = millis;
+        entries.insert(upper_bound(entries.begin(), entries.end(), entry, boardLess), entry);
+        rebuildTable();
+        return true;
+    }
+
+    // Record a finished game on the current board: reload, keep the
+    // player's best time and write the file back
+    void addScore(const string &playerName, uint32_t millis) {
+        load();
+        if (record(playerName, millis)) save();
+    }
+
+    // "MM:SS.cc", minutes growing past two digits as needed
+    static string formatTime(uint32_t millis) {
+        char text[32];
+        snprintf(text, sizeof(text), "%02u:%02u.%02u", millis / 60000, millis / 1000 % 60, millis / 10 % 100);
+        return text;
+    }
+
+    // Best times on the current board, fastest first
+    const vector<LeaderboardEntry> &getEntries() const { return table; }
+
+    // Every board's entries, sorted by board then time
+    const vector<LeaderboardEntry> &getAllEntries() const { return entries; }
+
+    size_t getSkippedLines() const { return skippedLines; }
+    const string &getPath() const { return path; }
+};
+
+#endif //LEADERBOARD_H
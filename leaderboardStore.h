@@ -0,0 +1,171 @@
+#ifndef LEADERBOARDSTORE_H
+#define LEADERBOARDSTORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "leaderboard.h"
+using namespace std;
+
+// One board's top times as last read or written by the store
+struct LeaderboardTable {
+    int cols = 0, rows = 0, mines = 0;
+    vector<LeaderboardEntry> entries; // Fastest first, at most Leaderboard::tableSize
+    unsigned long revision = 0;       // Every ticket up to this one is included
+};
+
+// The one path by which the game reads and writes the leaderboard. Scores
+// are queued and returned from immediately; a background worker reloads
+// the file, records every score that arrived within batchDelay of the
+// first, writes the file once and publishes the table of the last board
+// asked about. The UI picks that up with poll, so no frame waits on disk;
+// the ticket submit and request return tells it when a published table
+// reflects its call. Pending scores are written before the destructor
+// returns.
+class LeaderboardStore {
+private:
+    struct Score {
+        int cols, rows, mines;
+        uint32_t millis;
+        string name;
+    };
+
+    Leaderboard leaderboard;   // Worker thread only
+    chrono::milliseconds batchDelay;
+
+    mutex lock;
+    condition_variable wake;   // New work or shutdown
+    condition_variable idle;   // The worker has caught up
+    vector<Score> pending;
+    int wantedCols = 0, wantedRows = 0, wantedMines = 0;
+    bool tableWanted = false;
+    unsigned long lastTicket = 0;
+    bool busy = false;
+    bool stopping = false;
+    LeaderboardTable published;
+    bool unread = false;       // published hasn't been polled yet
+    unsigned long writes = 0;
+
+    thread worker;             // Started last, once the rest is set up
+
+    void work() {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [&] { return stopping || tableWanted || !pending.empty(); });
+            if (!tableWanted && pending.empty()) return; // Stopping with nothing left
+
+            // Let a burst of scores collect into a single write
+            if (!pending.empty() && !stopping) wake.wait_for(guard, batchDelay, [&] { return stopping; });
+
+            vector<Score> scores;
+            scores.swap(pending);
+            int cols = wantedCols, rows = wantedRows, mines = wantedMines;
+            unsigned long ticket = lastTicket;
+            tableWanted = false;
+            busy = true;
+            guard.unlock();
+
+            // Old "MM:SS,name" lines belong to whichever board is current
+            // when the file is read, so that must be the wanted one
+            leaderboard.setBoard(cols, rows, mines);
+            leaderboard.load();
+            bool changed = false;
+            for (const Score &score : scores) {
+                leaderboard.setBoard(score.cols, score.rows, score.mines);
+                changed |= leaderboard.record(score.name, score.millis);
+            }
+            bool saved = changed && leaderboard.save();
+            leaderboard.setBoard(cols, rows, mines);
+            LeaderboardTable table;
+            table.cols = cols;
+            table.rows = rows;
+            table.mines = mines;
+            table.entries = leaderboard.getEntries();
+            table.revision = ticket;
+
+            guard.lock();
+            published = move(table);
+            unread = true;
+            if (saved) writes++;
+            busy = false;
+            if (pending.empty() && !tableWanted) idle.notify_all();
+        }
+    }
+
+public:
+    explicit LeaderboardStore(const string &path = "files/leaderboard.txt",
+                              chrono::milliseconds batchDelay = chrono::milliseconds(50))
+        : leaderboard(path), batchDelay(batchDelay) {
+        worker = thread([this] { work(); });
+    }
+
+    ~LeaderboardStore() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+
+    LeaderboardStore(const LeaderboardStore &) = delete;
+    LeaderboardStore &operator=(const LeaderboardStore &) = delete;
+
+    // Queue a finished game; its board's table is published once written.
+    // Returns the ticket the table's revision reaches when it includes it.
+    unsigned long submit(int cols, int rows, int mines, const string &name, uint32_t millis) {
+        lock_guard<mutex> guard(lock);
+        pending.push_back(Score{cols, rows, mines, millis, name});
+        wantedCols = cols;
+        wantedRows = rows;
+        wantedMines = mines;
+        tableWanted = true;
+        wake.notify_all();
+        return ++lastTicket;
+    }
+
+    // Ask for a board's table to be read from the file and published;
+    // returns a ticket like submit
+    unsigned long request(int cols, int rows, int mines) {
+        lock_guard<mutex> guard(lock);
+        wantedCols = cols;
+        wantedRows = rows;
+        wantedMines = mines;
+        tableWanted = true;
+        wake.notify_all();
+        return ++lastTicket;
+    }
+
+    // Copy the newest table into table if it hasn't been polled yet
+    bool poll(LeaderboardTable &table) {
+        lock_guard<mutex> guard(lock);
+        if (!unread) return false;
+        table = published;
+        unread = false;
+        return true;
+    }
+
+    // True while submitted scores or a request haven't been published
+    bool isBusy() {
+        lock_guard<mutex> guard(lock);
+        return busy || tableWanted || !pending.empty();
+    }
+
+    // Block until everything queued so far is written and published
+    void flush() {
+        unique_lock<mutex> guard(lock);
+        idle.wait(guard, [&] { return !busy && !tableWanted && pending.empty(); });
+    }
+
+    // Number of times the file has been written
+    unsigned long getWrites() {
+        lock_guard<mutex> guard(lock);
+        return writes;
+    }
+};
+
+#endif //LEADERBOARDSTORE_H
@@ -5,10 +5,19 @@
 #include <cctype>
 #include <vector>
 #include <fstream>
-#include <random>
-#include <queue>
-#include "Gametile.h"
+#include <sstream>
+#include <cmath>
+#include <memory>
+#include "boardRenderer.h"
+#include "gameEngine.h"
+#include "infiniteEngine.h"
+#include "noGuessGenerator.h"
+#include "frameStats.h"
+#include "replay.h"
+#include "saveGame.h"
+#include "solver.h"
 #include "leaderboardWindow.h"
+#include "windowDispatcher.h"
 
 using namespace std;
 
@@ -65,9 +74,10 @@ public:
     void run() override {
         while (window.isOpen()) {
             sf::Event event;
-            while (window.pollEvent(event)) {
+            while (scheduler.waitEvent(window, event)) {
                 handleInput(event);
             }
+            if (!window.isOpen()) break;
 
             // Update cursor pos
             cursor.setPosition(
@@ -82,29 +92,85 @@ public:
             window.draw(userInput);
             window.draw(cursor);
             window.display();
+            if (scheduler.getFramesDrawn() == 0) AssetManager::shared().logFirstFrame("Welcome window");
+            scheduler.frameDrawn();
         }
     }
 
     bool shouldLaunch() const { return shouldLaunchGame; }
 };
 
+// HUD buttons, hit-tested through a small region table
+enum class HudAction { None, Leaderboard, Reset, Pause, Debug, Probabilities };
+
+struct HudRegion {
+    sf::FloatRect bounds;
+    HudAction action;
+};
+
 class GameWindow : public Window {
 private:
-    vector<vector<GameTile>> tiles;
-    sf::Texture hiddenTexture, revealedTexture, flagTexture, mineTexture;
-    vector<sf::Texture> numberTextures;
+    static const int tileSize = 32;   // Pixel size of one board cell
+    static const int hudHeight = 100; // Strip below the board for buttons
+
+    GameEngine engine;                // All game rules live here
+    InfiniteEngine infiniteEngine;    // Rules for the unbounded chunked board
+    bool infiniteMode = false;        // Config starts with "infinite"
+    int densityPercent = 15;          // Mine density in infinite mode
+    bool noGuess = false;             // Only deal boards solvable without guessing
+    unique_ptr<NoGuessGenerator> generator;
+    BoardRenderer boardRenderer{tileSize}; // One vertex array over a tile atlas
     int cols, rows, mines;
 
     // Button Textures and Sprites
-    sf::Texture happyFaceTexture, debugTexture, playTexture, leaderboardTexture, winFaceTexture, loseFaceTexture;
+    // Owned by the AssetManager, which shares them between windows
+    const sf::Texture *happyFaceTexture, *debugTexture, *playTexture, *leaderboardTexture, *winFaceTexture, *loseFaceTexture;
     sf::Sprite happyFaceButton, debugButton, playButton, leaderboardButton;
+    vector<HudRegion> hudRegions;     // In priority order
+
+    sf::View boardView;               // Zoomable, pannable camera over the board
+    sf::View hudView;                 // Fixed view for the HUD strip
+    float zoomLevel = 1.0f;           // Board units per screen pixel
+    bool panning = false;             // Middle button held down
+    sf::Vector2i lastPanPixel;
 
     bool debugMode = false;
     bool gameOver = false;
 
-    sf::Texture digitsTexture;
+    // Exact mine probability overlay, toggled beside the debug button
+    bool showProbabilities = false;
+    Solver solver;                    // Caches frontier components between clicks
+    const vector<float> *probabilities = nullptr;
+    sf::RenderTexture probabilityButtonTexture;
+    sf::Sprite probabilityButton;
+    sf::Text probabilityLabel;
+
+    // Frame timing and input-to-display latency, shown with F3
+    FrameStats frameStats;
+    bool showFrameStats = false;
+    bool frameCsv = false;            // Config "framecsv": write frame_stats.csv at exit
+    sf::Text frameStatsText;
+    sf::RectangleShape frameStatsBackground;
+
+    // Every bounded game is appended to the replay archive. Config
+    // "replay N" plays game N back instead (negative counts from the
+    // newest) at "speed S" times real time; speed 0 jumps to the end.
+    const string replayPath = "files/replays.bin";
+    Replay recording;                 // Moves of the game in progress
+    sf::Time moveTime;                // Game time of the move being handled
+    bool replayRequested = false;
+    int replayIndex = -1;
+    float replaySpeed = 1.0f;
+    bool replaying = false;
+    Replay playback;
+    ReplayPlayer replayPlayer;
+
+    // A game in progress is saved on pause and on close, and resumed
+    // (paused) at the next launch with the same board config
+    const string savePath = "files/save.bin";
+
+    const sf::Texture *digitsTexture = nullptr;
     sf::Sprite counterSprites[3];
-    int remainingMines;
 
     sf::Sprite timerMinutesSprites[2]; // Two sprites for the minutes (e.g., "01")
     sf::Sprite timerSecondsSprites[2]; // Two sprites for the seconds (e.g., "23")
@@ -112,7 +178,7 @@ private:
     int elapsedTime = 0;              // Total elapsed time in seconds
     int currentMinutes = 0;           // Minutes part of the timer
     int currentSeconds = 0;
-    sf::Texture pauseTexture;
+    const sf::Texture *pauseTexture = nullptr;
     sf::Time pausedTime;
     sf::Time elapsedBeforePause;
 
@@ -122,68 +188,96 @@ private:
 
 
     bool paused = false; // Tracks if the game is paused
-    std::vector<std::vector<bool>> tileRevealedStates; // Stores revealed states of tiles
-    std::vector<std::vector<bool>> tileFlaggedStates;  // Stores flagged states of tiles
 
 
     void loadConfig(const string &configPath) {
-        ifstream configFile(configPath);
-        if (!configFile) throw runtime_error("Unable to open config file");
-
-        configFile >> cols >> rows >> mines;
-    }
-
-    void loadTextures() {
-        if (!hiddenTexture.loadFromFile("files/images/tile_hidden.png") ||
-            !revealedTexture.loadFromFile("files/images/tile_revealed.png") ||
-            !flagTexture.loadFromFile("files/images/flag.png") ||
-            !mineTexture.loadFromFile("files/images/mine.png") ||
-            !digitsTexture.loadFromFile("files/images/digits.png")) {
-            throw runtime_error("Unable to load textures");
+        istringstream configFile(AssetManager::shared().file(configPath)); // Already read by main
+
+        // Either "cols rows mines" or "infinite densityPercent"
+        string first;
+        configFile >> first;
+        if (first == "infinite") {
+            infiniteMode = true;
+            if (!(configFile >> densityPercent)) throw runtime_error("Config \"infinite\" needs a mine density");
+            cols = rows = mines = 0;
+        } else {
+            istringstream number(first);
+            if (!(number >> cols) || !number.eof() || !(configFile >> rows >> mines)) {
+                throw runtime_error("Config needs \"cols rows mines\" or \"infinite density\"");
             }
+        }
 
-        numberTextures.resize(8);
-        for (int i = 1; i <= 8; ++i) {
-            if (!numberTextures[i - 1].loadFromFile("files/images/number_" + to_string(i) + ".png")) {
-                throw runtime_error("Unable to load number textures");
+        // Optional extras: a frame cap in frames per second (0 = none),
+        // "noguess", "framecsv", "replay N" and/or "speed S"
+        string option;
+        while (configFile >> option) {
+            if (option == "noguess") noGuess = true;
+            else if (option == "framecsv") frameCsv = true;
+            else if (option == "replay") {
+                if (!(configFile >> replayIndex)) throw runtime_error("Config \"replay\" needs a game number");
+                replayRequested = true;
+            } else if (option == "speed") {
+                if (!(configFile >> replaySpeed) || replaySpeed < 0) throw runtime_error("Config \"speed\" needs a speed of 0 or more");
+            } else {
+                // Anything else must be the frame cap, a whole number
+                istringstream number(option);
+                int frameCap;
+                if (!(number >> frameCap) || !number.eof()) throw runtime_error("Config option \"" + option + "\" is unknown");
+                if (frameCap < 0) throw runtime_error("Config frame cap needs to be 0 or more");
+                scheduler.setFrameCap(static_cast<unsigned>(frameCap));
             }
         }
     }
 
+    void loadTextures() {
+        AssetManager &assets = AssetManager::shared();
+        digitsTexture = &assets.texture("files/images/digits.png");
 
-    void loadButtonTextures() {
-        if (!happyFaceTexture.loadFromFile("files/images/face_happy.png") ||
-            !debugTexture.loadFromFile("files/images/debug.png") ||
-            !playTexture.loadFromFile("files/images/play.png") || // Load play.png
-            !pauseTexture.loadFromFile("files/images/pause.png") || // Load pause.png
-            !leaderboardTexture.loadFromFile("files/images/leaderboard.png") ||
-            !winFaceTexture.loadFromFile("files/images/face_win.png") ||
-            !loseFaceTexture.loadFromFile("files/images/face_lose.png")) {
-            throw runtime_error("Unable to load button textures");
-            }
-
-        happyFaceButton.setTexture(happyFaceTexture);
-        debugButton.setTexture(debugTexture);
-        playButton.setTexture(pauseTexture); // Initially set to pause
-        leaderboardButton.setTexture(leaderboardTexture);
+        // Tile, flag, mine and number images all go into one atlas
+        boardRenderer.loadAtlas(assets, "files/images/");
     }
 
 
-    void flagTile(GameTile &tile) {
-        if (tile.isRevealed()) return; // Ignore revealed tiles
-
-        bool wasFlagged = tile.getIsFlagged(); // Check current flag state
+    void loadButtonTextures() {
+        AssetManager &assets = AssetManager::shared();
+        happyFaceTexture = &assets.texture("files/images/face_happy.png");
+        debugTexture = &assets.texture("files/images/debug.png");
+        playTexture = &assets.texture("files/images/play.png");
+        pauseTexture = &assets.texture("files/images/pause.png");
+        leaderboardTexture = &assets.texture("files/images/leaderboard.png");
+        winFaceTexture = &assets.texture("files/images/face_win.png");
+        loseFaceTexture = &assets.texture("files/images/face_lose.png");
+
+        happyFaceButton.setTexture(*happyFaceTexture);
+        debugButton.setTexture(*debugTexture);
+        playButton.setTexture(*pauseTexture); // Initially set to pause
+        leaderboardButton.setTexture(*leaderboardTexture);
+
+        // No image ships for the probability toggle, so draw one: a hidden
+        // tile from the atlas with a percent sign on it
+        if (!probabilityButtonTexture.create(64, 64)) throw runtime_error("Unable to create button texture");
+        sf::Sprite tile(boardRenderer.getAtlas(), boardRenderer.slotRect(BoardRenderer::Hidden));
+        tile.setScale(64.0f / tileSize, 64.0f / tileSize);
+        sf::Text percent;
+        setText(percent, "%", 32, 24, 36, sf::Color::Black);
+        probabilityButtonTexture.clear(sf::Color::Transparent);
+        probabilityButtonTexture.draw(tile);
+        probabilityButtonTexture.draw(percent);
+        probabilityButtonTexture.display();
+        probabilityButton.setTexture(probabilityButtonTexture.getTexture());
+    }
 
-        // Toggle the flag state of the tile
-        tile.flag(flagTexture, hiddenTexture);
 
-        // Update the remaining mines count
-        if (wasFlagged) {
-            remainingMines++; // Unflagging increases the count
-        } else {
-            remainingMines--; // Flagging decreases the count
+    void flagTile(int row, int col) {
+        recordMove(ReplayAction::Flag, row, col);
+        bool changed = infiniteMode ? infiniteEngine.flag(row, col) : engine.flag(row, col);
+        if (!changed) {
+            unrecordMove();
+            return; // Ignore revealed tiles
         }
 
+        syncChangedTiles();
+
         // Update the counter display to reflect the new mine count
         updateCounter();
     }
@@ -194,33 +288,64 @@ private:
 
 
 
-    LeaderboardWindow* leaderboardWindow = nullptr;
-    bool isLeaderboardOpen = false;
-    // ... (other members remain the same)
+    // Created hidden with the game and shown on demand; a WindowDispatcher
+    // runs it from the game's own loop, so the board keeps drawing
+    unique_ptr<LeaderboardWindow> leaderboardWindow;
 
-    // New Method to Open Leaderboard
-    void openLeaderboard(const std::string &currentPlayerName, int currentTime) {
-        if (!leaderboardWindow) {
-            int leaderboardWidth = cols * 32;
-            int leaderboardHeight = rows * 16 + 50;
-            leaderboardWindow = new LeaderboardWindow(leaderboardWidth, leaderboardHeight);
-        }
+    // All leaderboard file I/O runs on the store's worker. The window shows
+    // the newest table it has published and is refreshed once the table
+    // covering leaderboardTicket arrives.
+    LeaderboardStore leaderboardStore;
+    LeaderboardTable leaderboardTable;
+    unsigned long leaderboardTicket = 0;
+    bool leaderboardPending = false;  // Waiting for leaderboardTicket
+    bool openWhenReady = false;       // Show the window when it arrives
+    string highlightName;
+    long long highlightTime = -1;     // Milliseconds, or -1 for none
 
-        // Open the leaderboard and pass the current player's details
-        leaderboardWindow->open(currentPlayerName, currentTime);
-        isLeaderboardOpen = true;
-    }
+    bool isLeaderboardOpen() const { return leaderboardWindow->isVisible(); }
 
+    // Show this board's leaderboard. The last table goes up at once and is
+    // refreshed when the reread arrives; currentTime is the player's time
+    // in milliseconds, or -1 for none.
+    void openLeaderboard(const std::string &currentPlayerName, long long currentTime) {
+        highlightName = currentPlayerName;
+        highlightTime = currentTime;
+        leaderboardTicket = leaderboardStore.request(cols, rows, mines);
+        leaderboardPending = true;
+        openWhenReady = leaderboardTable.revision == 0;
+        if (!openWhenReady) leaderboardWindow->open(leaderboardTable, highlightName, highlightTime);
+    }
 
+    // Queue a winning time and show the leaderboard once it holds it, so
+    // the win frame never waits on the file
+    void openLeaderboardWithScore(const std::string &currentPlayerName, uint32_t millis) {
+        highlightName = currentPlayerName;
+        highlightTime = millis;
+        leaderboardTicket = leaderboardStore.submit(cols, rows, mines, currentPlayerName, millis);
+        leaderboardPending = true;
+        openWhenReady = true;
+    }
 
+    // Take any table the store has published; keeps frames coming while
+    // one is awaited
+    void pollLeaderboard() {
+        if (leaderboardStore.poll(leaderboardTable) && leaderboardPending &&
+            leaderboardTable.revision >= leaderboardTicket) {
+            leaderboardPending = false;
+            if (openWhenReady) {
+                leaderboardWindow->open(leaderboardTable, highlightName, highlightTime);
+            } else if (isLeaderboardOpen()) {
+                leaderboardWindow->setTable(leaderboardTable);
+            }
+            openWhenReady = false;
+        }
+        if (leaderboardPending) scheduler.redrawIn(sf::milliseconds(16));
+    }
 
-    // New Method to Close Leaderboard
     void closeLeaderboard() {
-        if (leaderboardWindow) {
-            delete leaderboardWindow;
-            leaderboardWindow = nullptr;
-        }
-        isLeaderboardOpen = false;
+        openWhenReady = false;
+        leaderboardWindow->hide();
     }
 
 
@@ -229,11 +354,23 @@ private:
 
 
     void resetGame() {
+        finishRecording(); // Keep abandoned games too
+        discardSave();
+        if (replaying) stopPlayback();
+
         paused = false; // Reset paused state
+        boardRenderer.setCovered(false);
         gameOver = false;
         debugMode = false;
+        playButton.setTexture(*pauseTexture);
 
-        remainingMines = mines; // Reset the mine counter
+        // Fresh board with newly placed mines
+        if (infiniteMode) {
+            infiniteEngine.reset();
+        } else {
+            engine.reset();
+        }
+        syncTiles();
         updateCounter();
 
         // Restart the clock and reset the paused time
@@ -245,9 +382,7 @@ private:
         currentSeconds = 0;
         updateTimer();
 
-        happyFaceButton.setTexture(happyFaceTexture); // Reset happy face texture
-        initializeTiles(); // Reinitialize the board
-        placeMines(); // Randomly place mines
+        happyFaceButton.setTexture(*happyFaceTexture); // Reset happy face texture
     }
 
 
@@ -258,52 +393,28 @@ private:
 
 
 
-    bool checkWin() {
-        for (const auto &row : tiles) {
-            for (const auto &tile : row) {
-                if (!tile.isRevealed() && !tile.hasMine()) {
-                    return false; // If any hidden, non-mine tile exists, the game isn't won yet
-                }
-            }
-        }
-
-        // Flag all remaining mines
-        for (auto &row : tiles) {
-            for (auto &tile : row) {
-                if (tile.hasMine() && !tile.getIsFlagged()) {
-                    tile.flag(flagTexture, hiddenTexture); // Flag the mine if not already flagged
-                }
-            }
-        }
-
-        // Set remaining mines to 0 and update the counter
-        remainingMines = 0;
+    // Called by the engine once the last safe tile is revealed
+    void handleWin() {
+        syncChangedTiles();
         updateCounter();
+        finishRecording();
+        discardSave();
 
-        // Player wins: Capture winning time
-        sf::Time totalElapsedTime = elapsedBeforePause + gameClock.getElapsedTime();
-        int totalSeconds = static_cast<int>(totalElapsedTime.asSeconds());
-
-        // Ensure leaderboardWindow is initialized
-        if (!leaderboardWindow) {
-            leaderboardWindow = new LeaderboardWindow(cols * 32, rows * 16 + 50);
-        }
-
-        // Update the leaderboard
-        leaderboardWindow->addPlayerScore(playerName, totalSeconds);
-
-        // Save the leaderboard immediately
-        leaderboardWindow->saveLeaderboard();
-
-        // Automatically open the leaderboard after a win
-        openLeaderboard(playerName, totalSeconds);
+        // Player wins: the time of the winning click, as the replay records it
+        uint32_t totalMillis = static_cast<uint32_t>(moveTime.asMilliseconds());
 
         // Update UI and game state
-        happyFaceButton.setTexture(winFaceTexture);
+        happyFaceButton.setTexture(*winFaceTexture);
         gameOver = true; // Stop the game and timer
+        if (replaying) {
+            // A replayed win was scored when it was played
+            cout << "Replay won by " << playback.player << " in " << Leaderboard::formatTime(totalMillis) << endl;
+            return;
+        }
         cout << "You Win!" << endl;
 
-        return true;
+        // Automatically open the leaderboard once the time is recorded
+        openLeaderboardWithScore(playerName, totalMillis);
     }
 
 
@@ -322,31 +433,40 @@ private:
 
 
     void positionButtons() {
-        int buttonRowY = 32 * (rows + 0.5); // Y position of the buttons
+        int buttonRowY = boardAreaHeight() + 16; // Y position of the buttons
 
         // Position buttons based on the given formulas
-        happyFaceButton.setPosition((cols * 32) / 2 - 32, buttonRowY);
-        debugButton.setPosition((cols * 32) - 304, buttonRowY);
-        playButton.setPosition((cols * 32) - 240, buttonRowY);
-        leaderboardButton.setPosition((cols * 32) - 176, buttonRowY);
+        happyFaceButton.setPosition(width / 2 - 32, buttonRowY);
+        debugButton.setPosition(width - 304, buttonRowY);
+        probabilityButton.setPosition(width - 368, buttonRowY);
+        playButton.setPosition(width - 240, buttonRowY);
+        leaderboardButton.setPosition(width - 176, buttonRowY);
+
+        hudRegions = {
+            {leaderboardButton.getGlobalBounds(), HudAction::Leaderboard},
+            {happyFaceButton.getGlobalBounds(), HudAction::Reset},
+            {playButton.getGlobalBounds(), HudAction::Pause},
+            {debugButton.getGlobalBounds(), HudAction::Debug},
+        };
+        if (!infiniteMode) hudRegions.push_back({probabilityButton.getGlobalBounds(), HudAction::Probabilities});
     }
 
 
     void positionTimer() {
-        int rowsYOffset = 32 * (rows + 0.5) + 16;
-        int minutesStartX = (cols * 32) - 97;
-        int secondsStartX = (cols * 32) - 54;
+        int rowsYOffset = boardAreaHeight() + 32;
+        int minutesStartX = width - 97;
+        int secondsStartX = width - 54;
 
         std::cout << "Minutes Timer Position: (" << minutesStartX << ", " << rowsYOffset << ")\n";
         std::cout << "Seconds Timer Position: (" << secondsStartX << ", " << rowsYOffset << ")\n";
 
         for (int i = 0; i < 2; ++i) {
-            timerMinutesSprites[i].setTexture(digitsTexture);
+            timerMinutesSprites[i].setTexture(*digitsTexture);
             timerMinutesSprites[i].setPosition(minutesStartX + (i * 21), rowsYOffset);
             timerMinutesSprites[i].setTextureRect(sf::IntRect(0, 0, 21, 32));
         }
         for (int i = 0; i < 2; ++i) {
-            timerSecondsSprites[i].setTexture(digitsTexture);
+            timerSecondsSprites[i].setTexture(*digitsTexture);
             timerSecondsSprites[i].setPosition(secondsStartX + (i * 21), rowsYOffset);
             timerSecondsSprites[i].setTextureRect(sf::IntRect(0, 0, 21, 32));
         }
@@ -357,8 +477,7 @@ private:
     void updateTimer() {
         if (gameOver || paused) return; // Do not update timer if game is over or paused
 
-        sf::Time totalElapsedTime = elapsedBeforePause + gameClock.getElapsedTime();
-        int totalSeconds = static_cast<int>(totalElapsedTime.asSeconds());
+        int totalSeconds = static_cast<int>(gameTime().asSeconds());
         currentMinutes = totalSeconds / 60;
         currentSeconds = totalSeconds % 60;
 
@@ -383,16 +502,18 @@ private:
 
     void positionCounter() {
         int startX = 33; // Starting x-coordinate
-        int startY = 32 * (rows + 0.5) + 16; // Starting y-coordinate
+        int startY = boardAreaHeight() + 32; // Starting y-coordinate
 
         for (int i = 0; i < 3; ++i) {
-            counterSprites[i].setTexture(digitsTexture);
+            counterSprites[i].setTexture(*digitsTexture);
             counterSprites[i].setPosition(startX + (i * 21), startY); // Offset by 21px for each digit
         }
     }
 
 
     void updateCounter() {
+        // The infinite board has no mine total, so it counts flags instead
+        int remainingMines = infiniteMode ? infiniteEngine.getFlagsPlaced() : engine.getRemainingMines();
         int count = abs(remainingMines); // Use absolute value for digit extraction
         for (int i = 2; i >= 0; --i) {
             int digit = count % 10; // Extract the last digit
@@ -409,212 +530,413 @@ private:
 
 
 
-    void initializeTiles() {
-        tiles.clear();
-        tileRevealedStates.resize(rows, std::vector<bool>(cols, false));
-        tileFlaggedStates.resize(rows, std::vector<bool>(cols, false));
+    int boardAreaHeight() const { return height - hudHeight; }
 
-        for (int i = 0; i < rows; ++i) {
-            vector<GameTile> row;
-            for (int j = 0; j < cols; ++j) {
-                GameTile tile(hiddenTexture);
-                tile.setPosition(j * 32, i * 32);
-                row.push_back(tile);
-            }
-            tiles.push_back(row);
-        }
-
-        // Assign adjacent tiles for recursive revealing
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        if (dr == 0 && dc == 0) continue;
-                        int nr = r + dr, nc = c + dc;
-                        if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
-                            tiles[r][c].addAdjacentTile(&tiles[nr][nc]);
-                        }
-                    }
-                }
-            }
-        }
+    // Fit the camera to the board area at 1:1 scale, top-left aligned
+    void resetCamera() {
+        float areaHeight = static_cast<float>(boardAreaHeight());
+        zoomLevel = 1.0f;
+        boardView.setViewport(sf::FloatRect(0, 0, 1, areaHeight / height));
+        boardView.setSize(static_cast<float>(width), areaHeight);
+        boardView.setCenter(width / 2.0f, areaHeight / 2.0f);
+        hudView = window.getDefaultView();
+    }
+
+    // Keep the camera center over the board so it can't be lost
+    void clampCamera() {
+        scheduler.markDirty(FrameScheduler::Board);
+        if (infiniteMode) return;
+        sf::Vector2f center = boardView.getCenter();
+        center.x = max(0.0f, min(center.x, static_cast<float>(cols * tileSize)));
+        center.y = max(0.0f, min(center.y, static_cast<float>(rows * tileSize)));
+        boardView.setCenter(center);
     }
 
+    // Zoom by factor keeping the board point under the cursor fixed
+    void zoomAt(int pixelX, int pixelY, float factor) {
+        float newZoom = zoomLevel * factor;
+        if (newZoom < 0.25f || newZoom > 8.0f) return; // 128px down to 4px tiles
+
+        sf::Vector2i pixel(pixelX, pixelY);
+        sf::Vector2f before = window.mapPixelToCoords(pixel, boardView);
+        boardView.zoom(factor);
+        zoomLevel = newZoom;
+        sf::Vector2f after = window.mapPixelToCoords(pixel, boardView);
+        boardView.move(before - after);
+        clampCamera();
+    }
 
-    void placeMines() {
-        int minesToPlace = mines;
-        random_device rd;
-        mt19937 gen(rd());
-        uniform_int_distribution<> rowDist(0, rows - 1);
-        uniform_int_distribution<> colDist(0, cols - 1);
+    void panBy(const sf::Vector2i &from, const sf::Vector2i &to) {
+        boardView.move(window.mapPixelToCoords(from, boardView) - window.mapPixelToCoords(to, boardView));
+        clampCamera();
+    }
 
-        while (minesToPlace > 0) {
-            int row = rowDist(gen);
-            int col = colDist(gen);
-            if (!tiles[row][col].hasMine()) {
-                tiles[row][col].setMine(true);
-                minesToPlace--;
-            }
+    // Only cells overlapping the camera get vertices
+    void updateVisibleRange() {
+        sf::Vector2f center = boardView.getCenter();
+        sf::Vector2f half = boardView.getSize() / 2.0f;
+        int colBegin = static_cast<int>(floor((center.x - half.x) / tileSize));
+        int colEnd = static_cast<int>(ceil((center.x + half.x) / tileSize));
+        int rowBegin = static_cast<int>(floor((center.y - half.y) / tileSize));
+        int rowEnd = static_cast<int>(ceil((center.y + half.y) / tileSize));
+        if (infiniteMode) {
+            boardRenderer.setVisibleRange(infiniteEngine.getBoard(), rowBegin, rowEnd, colBegin, colEnd);
+            return;
         }
-
-        calculateAdjacentMines();
+        boardRenderer.setVisibleRange(engine.getBoard(), max(0, rowBegin), min(rows, rowEnd),
+                                      max(0, colBegin), min(cols, colEnd));
     }
 
-    void calculateAdjacentMines() {
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                if (tiles[r][c].hasMine()) continue;
 
-                int mineCount = 0;
-                for (auto neighbor : tiles[r][c].getAdjacentTiles()) {
-                    if (neighbor->hasMine()) {
-                        mineCount++;
-                    }
-                }
-                tiles[r][c].setAdjacentMines(mineCount);
-            }
+    // Refresh every tile quad from the engine's board
+    void syncTiles() {
+        if (infiniteMode) {
+            boardRenderer.setDebugMode(debugMode);
+            boardRenderer.updateAll(infiniteEngine.getBoard());
+        } else {
+            boardRenderer.setDebugMode(debugMode, engine.getBoard(), engine.getMineCells());
+            boardRenderer.updateAll(engine.getBoard());
+            updateProbabilities();
         }
+        scheduler.markDirty(FrameScheduler::Board);
     }
 
-    void handleInput(sf::Event &event) {
-    if (event.type == sf::Event::Closed) {
-        window.close();
-        if (isLeaderboardOpen) closeLeaderboard();
-    } else if (event.type == sf::Event::MouseButtonPressed) {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-
-        // Handle leaderboard button interaction (always allow opening leaderboard)
-        if (leaderboardButton.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-            if (!isLeaderboardOpen) {
-                openLeaderboard(playerName, elapsedTime); // Open leaderboard with current player's name and time
-            } else {
-                closeLeaderboard(); // Close leaderboard if already open
+    // Refresh only the quads the engine's last action touched
+    void syncChangedTiles() {
+        if (infiniteMode) {
+            const InfiniteBoard &board = infiniteEngine.getBoard();
+            for (const CellPos &cell : infiniteEngine.getChangedCells()) {
+                boardRenderer.updateCell(board, cell.row, cell.col);
             }
-            return;
+        } else {
+            const Board &board = engine.getBoard();
+            for (int idx : engine.getChangedCells()) {
+                boardRenderer.updateCell(board, idx);
+            }
+            updateProbabilities();
         }
+        scheduler.markDirty(FrameScheduler::Board);
+    }
 
-        // Handle happy face button interaction (always allow reset)
-        if (happyFaceButton.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-            resetGame();
-            return;
+    // Recompute the overlay from what the player can see. Frontier pieces
+    // the last action didn't touch come from the solver's cache.
+    void updateProbabilities() {
+        if (showProbabilities && !infiniteMode && !engine.isGameOver()) {
+            probabilities = &solver.mineProbabilities(engine.getBoard(), engine.getMines());
+        } else {
+            probabilities = nullptr;
         }
+        boardRenderer.setOverlay(probabilities ? &engine.getBoard() : nullptr, probabilities);
+    }
 
-        // Handle pause/resume button
-        if (!gameOver && playButton.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-            togglePause();
-            return;
+    // Percentages over the tinted cells, skipped when zoomed too far out
+    // to read them
+    void drawProbabilityLabels() {
+        if (!probabilities || zoomLevel > 1.5f) return;
+        const Board &board = engine.getBoard();
+        for (int r = boardRenderer.getRowBegin(); r < boardRenderer.getRowEnd(); ++r) {
+            for (int c = boardRenderer.getColBegin(); c < boardRenderer.getColEnd(); ++c) {
+                int idx = board.index(r, c);
+                float value = (*probabilities)[idx];
+                if (value < 0 || board.isRevealed(idx)) continue;
+                setText(probabilityLabel, to_string(static_cast<int>(lround(value * 100))) + "%",
+                        (c + 0.5f) * tileSize, (r + 0.5f) * tileSize, 11, sf::Color::Black);
+                window.draw(probabilityLabel);
+            }
         }
+    }
 
-        // Handle debug button interaction (disable interaction if paused)
-        if (!paused && debugButton.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-            debugMode = !debugMode;
-            return;
-        }
+    // Events whose effect the player waits to see; plain cursor motion
+    // only counts while it drags the board
+    bool isMouseInput(const sf::Event &event) const {
+        return event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseButtonReleased ||
+               event.type == sf::Event::MouseWheelScrolled || (event.type == sf::Event::MouseMoved && panning);
+    }
 
-        // Handle tile interactions (disable interaction if game is over or paused)
-        if (!gameOver && !paused) {
-            for (auto &row : tiles) {
-                for (auto &tile : row) {
-                    if (tile.getBounds().contains(mousePos.x, mousePos.y)) {
-                        if (event.mouseButton.button == sf::Mouse::Left) {
-                            revealTile(tile);
-                        } else if (event.mouseButton.button == sf::Mouse::Right) {
-                            flagTile(tile);
-                        }
-                        return;
-                    }
-                }
-            }
+    // Rolling frame and latency percentiles in the top-left corner, in the
+    // HUD view. Refreshed a few times a second while shown.
+    void drawFrameStats() {
+        if (!showFrameStats) return;
+        scheduler.redrawIn(sf::milliseconds(250));
+
+        char line[96];
+        string report = "last frames    p50     p99     max  ms\n";
+        auto append = [&](const char *name, const FrameStats::Summary &summary) {
+            snprintf(line, sizeof(line), "%-10s %7.2f %7.2f %7.2f\n", name, summary.p50, summary.p99, summary.max);
+            report += line;
+        };
+        for (int p = 0; p < FrameStats::PhaseCount; ++p) {
+            FrameStats::Phase phase = static_cast<FrameStats::Phase>(p);
+            append(FrameStats::phaseName(phase), frameStats.phaseSummary(phase));
         }
+        append("frame", frameStats.frameSummary());
+        FrameStats::Summary latency = frameStats.latencySummary();
+        append("input", latency);
+        report += to_string(latency.samples) + " inputs";
+
+        frameStatsText.setFont(font);
+        frameStatsText.setString(report);
+        frameStatsText.setCharacterSize(12);
+        frameStatsText.setFillColor(sf::Color::White);
+        frameStatsText.setPosition(8, 6);
+        sf::FloatRect bounds = frameStatsText.getGlobalBounds();
+        frameStatsBackground.setPosition(0, 0);
+        frameStatsBackground.setSize(sf::Vector2f(bounds.left + bounds.width + 8, bounds.top + bounds.height + 8));
+        frameStatsBackground.setFillColor(sf::Color(0, 0, 0, 160));
+        window.draw(frameStatsBackground);
+        window.draw(frameStatsText);
     }
-}
-
 
+    // Time played so far, excluding pauses; replays run it at replaySpeed
+    sf::Time gameTime() const {
+        sf::Time played = elapsedBeforePause + gameClock.getElapsedTime();
+        return replaying ? played * replaySpeed : played;
+    }
 
+    // Moves are recorded before they reach the engine, so a game that ends
+    // on one is complete when the win/loss handlers save it
+    void recordMove(ReplayAction action, int row, int col) {
+        if (replaying || infiniteMode) return;
+        recording.moves.push_back({static_cast<uint32_t>(moveTime.asMilliseconds()), action, row, col});
+    }
 
+    // Forget the last move again when it changed nothing
+    void unrecordMove() {
+        if (!replaying && !infiniteMode && !recording.moves.empty()) recording.moves.pop_back();
+    }
 
+    // Append the current game to the replay archive, if it had any moves
+    void finishRecording() {
+        if (replaying || infiniteMode || recording.moves.empty()) return;
+        recording.cols = cols;
+        recording.rows = rows;
+        recording.mines = mines;
+        recording.firstClickSafe = engine.isFirstClickSafe();
+        recording.seed = engine.getSeed(); // After any no-guess search
+        recording.player = playerName;
+        try {
+            recording.append(replayPath);
+        } catch (const runtime_error &e) {
+            cerr << "Error: " << e.what() << endl;
+        }
+        recording.moves.clear();
+    }
 
-    void checkWinAndUpdateLeaderboard() {
-    // Player wins: Capture winning time
-    sf::Time totalElapsedTime = elapsedBeforePause + gameClock.getElapsedTime();
-    int totalSeconds = static_cast<int>(totalElapsedTime.asSeconds());
+    // Save the game in progress for the next launch; false if there is
+    // nothing worth resuming or the save failed
+    bool autosave() {
+        if (infiniteMode || replaying || gameOver || !engine.areMinesPlaced()) return false;
+        sf::Time played = paused ? elapsedBeforePause : gameTime();
+        try {
+            SaveGame::save(savePath, engine, static_cast<uint32_t>(played.asMilliseconds()), recording);
+        } catch (const runtime_error &e) {
+            cerr << "Error: " << e.what() << endl;
+            return false;
+        }
+        return true;
+    }
 
-    // Set remaining mines to 0 and update the counter display
-    remainingMines = 0;
-    updateCounter();
+    // A finished or abandoned game can't be resumed
+    void discardSave() {
+        if (!replaying) remove(savePath.c_str());
+    }
 
-    // Automatically flag all remaining mines when the player wins
-    for (auto &row : tiles) {
-        for (auto &tile : row) {
-            if (!tile.isRevealed() && tile.hasMine() && !tile.getIsFlagged()) {
-                tile.flag(flagTexture, hiddenTexture); // Flag the mine if not already flagged
-            }
+    // Pick up the autosaved game if it was played on this board config.
+    // It comes back paused, as it was saved, with its replay so far.
+    void resumeSavedGame() {
+        uint32_t playedMillis = 0;
+        try {
+            if (!SaveGame::load(savePath, engine, playedMillis, recording)) return;
+        } catch (const exception &e) {
+            cerr << "Ignoring saved game: " << e.what() << endl;
+            engine.setFirstClickSafe(true);
+            engine.configure(cols, rows, mines);
+            return;
+        }
+        if (engine.getCols() != cols || engine.getRows() != rows || engine.getMines() != mines ||
+            engine.isGameOver()) {
+            cout << "Saved game is for another board; starting a new one" << endl;
+            engine.setFirstClickSafe(true);
+            engine.configure(cols, rows, mines);
+            recording = Replay();
+            return;
         }
-    }
 
-    // Load the leaderboard entries from the file
-    vector<LeaderboardEntry> currentEntries;
-    ifstream leaderboardFile("files/leaderboard.txt");
-    if (leaderboardFile.is_open()) {
-        string line;
-        while (getline(leaderboardFile, line)) {
-            stringstream ss(line);
-            string timeStr, name;
-            getline(ss, timeStr, ',');
-            getline(ss, name);
+        elapsedBeforePause = sf::milliseconds(static_cast<sf::Int32>(playedMillis));
+        gameClock.restart();
+        updateTimer();
+        paused = true;
+        boardRenderer.setCovered(true);
+        playButton.setTexture(*playTexture);
+        cout << "Resumed saved game at " << playedMillis / 1000 << " s (paused)" << endl;
+    }
 
-            // Convert time format (MM:SS) to total seconds
-            int minutes = stoi(timeStr.substr(0, 2));
-            int seconds = stoi(timeStr.substr(3, 2));
-            int totalTime = minutes * 60 + seconds;
+    // Load the requested game; the window takes over its board size
+    void loadPlayback() {
+        vector<Replay> games = Replay::loadAll(replayPath);
+        int count = static_cast<int>(games.size());
+        int chosen = replayIndex < 0 ? count + replayIndex : replayIndex;
+        if (chosen < 0 || chosen >= count) {
+            throw runtime_error("No game " + to_string(replayIndex) + " in " + replayPath);
+        }
+        playback = move(games[chosen]);
+        infiniteMode = false;
+        cols = playback.cols;
+        rows = playback.rows;
+        mines = playback.mines;
+    }
 
-            currentEntries.push_back({totalTime, timeStr, name});
+    void startPlayback() {
+        engine.setSeedPicker(nullptr); // The recorded seed was already picked
+        replayPlayer.start(playback, engine);
+        replaying = true;
+        if (replaySpeed == 0) {
+            // Instant: start the clock at the last move so everything is due
+            replaySpeed = 1;
+            if (!playback.moves.empty()) elapsedBeforePause = sf::milliseconds(playback.moves.back().millis);
         }
-        leaderboardFile.close();
+        cout << "Replaying a game by " << playback.player << ", " << playback.moves.size() << " moves" << endl;
     }
 
+    void stopPlayback() {
+        replaying = false;
+        engine.setFirstClickSafe(true);
+        installSeedPicker();
+    }
 
-    string formattedTime = LeaderboardWindow::formatTime(totalSeconds);
-    currentEntries.push_back({totalSeconds, formattedTime, playerName});
+    // Apply every recorded move that is due, then wake up for the next one
+    void advanceReplay() {
+        uint32_t now = static_cast<uint32_t>(gameTime().asMilliseconds());
+        while (!gameOver) {
+            const ReplayMove *move = replayPlayer.due(now);
+            if (!move) break;
+            moveTime = sf::milliseconds(static_cast<sf::Int32>(move->millis));
+            switch (move->action) {
+                case ReplayAction::Reveal: revealTile(move->row, move->col); break;
+                case ReplayAction::Flag: flagTile(move->row, move->col); break;
+                case ReplayAction::Chord: chordTile(move->row, move->col); break;
+            }
+        }
+        if (!gameOver && !replayPlayer.finished()) {
+            scheduler.redrawIn(sf::milliseconds(static_cast<sf::Int32>((replayPlayer.nextMillis() - now) / replaySpeed) + 1));
+        }
+    }
 
+    // In no-guess mode the layout is searched for when the first click lands
+    void installSeedPicker() {
+        if (!generator) return;
+        engine.setSeedPicker([this](uint64_t seed, int row, int col) {
+            uint64_t chosen;
+            bool found = generator->generate(cols, rows, mines, row, col, seed, chosen);
+            cout << (found ? "No-guess board after " : "No no-guess board in ") << generator->getLastCandidates()
+                 << " candidates, " << generator->getLastMillis() << " ms\n";
+            return chosen;
+        });
+    }
 
-    sort(currentEntries.begin(), currentEntries.end(), [](const LeaderboardEntry &a, const LeaderboardEntry &b) {
-        return a.time < b.time;
-    });
-    if (currentEntries.size() > 5) {
-        currentEntries.resize(5);
+    // Map a window pixel to a board cell through the board view; false if
+    // the point is off the board
+    bool cellAt(int pixelX, int pixelY, int &row, int &col) const {
+        if (pixelY >= boardAreaHeight()) return false; // Over the HUD
+        sf::Vector2f world = window.mapPixelToCoords(sf::Vector2i(pixelX, pixelY), boardView);
+        col = static_cast<int>(floor(world.x / tileSize));
+        row = static_cast<int>(floor(world.y / tileSize));
+        return infiniteMode || (row >= 0 && row < rows && col >= 0 && col < cols);
     }
 
-    // Check if the player's score is in the top 5
-    bool isInTop5 = false;
-    for (const auto &entry : currentEntries) {
-        if (entry.name == playerName && entry.time == totalSeconds) {
-            isInTop5 = true;
-            break;
+    // First HUD button under a window pixel, if any
+    HudAction hudActionAt(int pixelX, int pixelY) const {
+        sf::Vector2f point = window.mapPixelToCoords(sf::Vector2i(pixelX, pixelY), hudView);
+        for (const auto &region : hudRegions) {
+            if (region.bounds.contains(point.x, point.y)) return region.action;
         }
+        return HudAction::None;
     }
 
-    // Write the updated leaderboard back to the file
-    if (isInTop5) {
-        ofstream leaderboardOutFile("files/leaderboard.txt", ios::trunc);
-        if (leaderboardOutFile.is_open()) {
-            for (const auto &entry : currentEntries) {
-                leaderboardOutFile << entry.formattedTime << "," << entry.name << endl;
-            }
-            leaderboardOutFile.close();
+    void handleInput(sf::Event &event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+        if (isLeaderboardOpen()) closeLeaderboard();
+    } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        showFrameStats = !showFrameStats;
+    } else if (event.type == sf::Event::MouseWheelScrolled) {
+        // Zoom the board around the cursor
+        if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel &&
+            event.mouseWheelScroll.y < boardAreaHeight() && event.mouseWheelScroll.delta != 0) {
+            zoomAt(event.mouseWheelScroll.x, event.mouseWheelScroll.y, event.mouseWheelScroll.delta > 0 ? 0.8f : 1.25f);
+        }
+    } else if (event.type == sf::Event::MouseMoved) {
+        if (panning) {
+            sf::Vector2i pixel(event.mouseMove.x, event.mouseMove.y);
+            panBy(lastPanPixel, pixel);
+            lastPanPixel = pixel;
+        }
+    } else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Middle) panning = false;
+    } else if (event.type == sf::Event::MouseButtonPressed) {
+        // Use the position carried by the event, not the live cursor
+        int x = event.mouseButton.x;
+        int y = event.mouseButton.y;
+
+        // Middle-drag pans the board
+        if (event.mouseButton.button == sf::Mouse::Middle) {
+            panning = y < boardAreaHeight();
+            lastPanPixel = sf::Vector2i(x, y);
+            return;
         }
-    }
 
+        switch (hudActionAt(x, y)) {
+            case HudAction::Leaderboard: // Always allow opening leaderboard
+                if (!isLeaderboardOpen()) {
+                    openLeaderboard(playerName, -1); // Mid-game, so there is no time to highlight
+                } else {
+                    closeLeaderboard(); // Close leaderboard if already open
+                }
+                return;
+            case HudAction::Reset: // Always allow reset
+                resetGame();
+                return;
+            case HudAction::Pause:
+                if (!gameOver) togglePause();
+                return;
+            case HudAction::Debug: // Disabled while paused
+                if (!paused) {
+                    debugMode = !debugMode;
+                    syncTiles();
+                }
+                return;
+            case HudAction::Probabilities: // Disabled while paused
+                if (!paused) {
+                    showProbabilities = !showProbabilities;
+                    updateProbabilities();
+                    scheduler.markDirty(FrameScheduler::Board);
+                }
+                return;
+            case HudAction::None:
+                break;
+        }
 
-    if (isInTop5 && !isLeaderboardOpen) {
-        openLeaderboard(playerName, totalSeconds);
+        // Handle tile interactions (disable interaction if game is over,
+        // paused or replaying)
+        int r, c;
+        if (!gameOver && !paused && !replaying && cellAt(x, y, r, c)) {
+            moveTime = gameTime();
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                // Clicking an already revealed number chords it
+                bool revealed = infiniteMode ? infiniteEngine.getBoard().isRevealed(r, c) : engine.isRevealed(r, c);
+                if (revealed) {
+                    chordTile(r, c);
+                } else {
+                    revealTile(r, c);
+                }
+            } else if (event.mouseButton.button == sf::Mouse::Right) {
+                flagTile(r, c);
+            }
+        }
     }
+}
 
 
-    happyFaceButton.setTexture(winFaceTexture);
-    gameOver = true; // Stop the game and timer
-    cout << "You Win!" << endl;
-}
 
 
 
@@ -623,27 +945,20 @@ private:
 
 
 
-    void revealAllMinesAfterLoss() {
-        for (auto &row : tiles) {
-            for (auto &tile : row) {
-                if (tile.hasMine()) {
-                    // Use the specialized reveal method to handle flags and mines correctly
-                    tile.revealMineAfterLoss(mineTexture);
-                }
-            }
-        }
-    }
 
 
 
 
+    // Called by the engine when a mine is revealed; it has already
+    // uncovered every mine, flagged or not
     void loseGame() {
+        syncChangedTiles();
+        finishRecording();
+        discardSave();
+
         // Set game state to over
         gameOver = true;
-        happyFaceButton.setTexture(loseFaceTexture);
-
-        // Reveal all mines, including those with flags
-        revealAllMinesAfterLoss();
+        happyFaceButton.setTexture(*loseFaceTexture);
     }
 
 
@@ -656,30 +971,16 @@ private:
         if (gameOver) return; // Prevent pause/unpause if the game is over
 
         paused = !paused; // Toggle pause state
+        boardRenderer.setCovered(paused); // Just a render mode; no tile changes
 
         if (paused) {
-            playButton.setTexture(playTexture); // Show the play icon
+            playButton.setTexture(*playTexture); // Show the play icon
             elapsedBeforePause += gameClock.getElapsedTime(); // Save the elapsed time
             gameClock.restart(); // Restart the clock to track pause duration
-
-            // Save states and override all tiles with revealed texture for visual feedback
-            for (auto &row : tiles) {
-                for (auto &tile : row) {
-                    tile.savePauseState();
-                    tile.setPausedTexture(revealedTexture); // Force tile to appear revealed
-                }
-            }
+            autosave();
         } else {
-            playButton.setTexture(pauseTexture); // Show the pause icon
+            playButton.setTexture(*pauseTexture); // Show the pause icon
             gameClock.restart(); // Restart the clock for post-pause timing
-
-            // Restore states for all tiles
-            for (auto &row : tiles) {
-                for (auto &tile : row) {
-                    tile.restorePauseState();
-                    tile.restoreTexture(hiddenTexture, flagTexture, revealedTexture, numberTextures);
-                }
-            }
         }
     }
 
@@ -707,54 +1008,43 @@ private:
 
 
 
-    void revealTile(GameTile &tile) {
-
-        if (tile.getIsFlagged() || tile.isRevealed()) return;
+    void revealTile(int row, int col) {
+        if (infiniteMode) {
+            // Losses are reported through the engine's handler
+            if (infiniteEngine.reveal(row, col) && !infiniteEngine.isGameOver()) syncChangedTiles();
+            return;
+        }
 
-        if (tile.hasMine()) {
-            
-            for (auto &row : tiles) {
-                for (auto &t : row) {
-                    if (t.hasMine()) {
-                        t.reveal(revealedTexture, nullptr, &mineTexture);
-                    }
-                }
-            }
-            happyFaceButton.setTexture(loseFaceTexture);
-            gameOver = true;
+        bool minesWerePlaced = engine.areMinesPlaced();
+        recordMove(ReplayAction::Reveal, row, col);
+        if (!engine.reveal(row, col)) {
+            unrecordMove();
             return;
         }
 
-        if (tile.getAdjacentMines() > 0) {
-            tile.reveal(revealedTexture, &numberTextures[tile.getAdjacentMines() - 1]);
-        } else {
-            queue<GameTile *> toReveal;
-            toReveal.push(&tile);
-            tile.reveal(revealedTexture);  // Mark the initial tile as revealed
-
-            while (!toReveal.empty()) {
-                GameTile *current = toReveal.front();
-                toReveal.pop();
-
-                for (auto neighbor : current->getAdjacentTiles()) {
-                    if (!neighbor->isRevealed() && !neighbor->hasMine() && !neighbor->getIsFlagged()) {
-                        neighbor->reveal(revealedTexture);
-
-                        if (neighbor->getAdjacentMines() == 0) {
-                            toReveal.push(neighbor);
-                        } else {
-                            neighbor->reveal(revealedTexture, &numberTextures[neighbor->getAdjacentMines() - 1]);
-                        }
-                    }
-                }
-            }
+        // The first click places the mines; show them if debug is on
+        if (!minesWerePlaced && debugMode) {
+            boardRenderer.setDebugMode(true, engine.getBoard(), engine.getMineCells());
+        }
+
+        // Win and loss are reported through the engine's handlers
+        if (!engine.isGameOver()) syncChangedTiles();
+    }
+
+
+    void chordTile(int row, int col) {
+        if (infiniteMode) {
+            if (infiniteEngine.chord(row, col) && !infiniteEngine.isGameOver()) syncChangedTiles();
+            return;
         }
 
-        // Check if the player has won
-        if (checkWin()) {
-            happyFaceButton.setTexture(winFaceTexture);
-            gameOver = true;
+        recordMove(ReplayAction::Chord, row, col);
+        if (!engine.chord(row, col)) {
+            unrecordMove();
+            return;
         }
+
+        if (!engine.isGameOver()) syncChangedTiles();
     }
 
 
@@ -767,68 +1057,119 @@ public:
     GameWindow(const string &configPath, int width, int height, const string &playerName)
     : Window(width, height, "Minesweeper Game"), playerName(playerName) {
         loadConfig(configPath);
+        if (replayRequested) loadPlayback();
+        frameStats.setKeepHistory(frameCsv);
         loadTextures();
         loadButtonTextures();
-        initializeTiles();
+        engine.setWinHandler([this]() { handleWin(); });
+        engine.setLossHandler([this]() { loseGame(); });
+        engine.setFirstClickSafe(true); // Mines are placed around the first click
+        if (noGuess && !infiniteMode) {
+            generator.reset(new NoGuessGenerator());
+            installSeedPicker();
+        }
+        infiniteEngine.setLossHandler([this]() { loseGame(); });
+        if (infiniteMode) {
+            infiniteEngine.configure(densityPercent / 100.0);
+        } else {
+            engine.configure(cols, rows, mines);
+            if (replayRequested) {
+                startPlayback();
+            } else {
+                resumeSavedGame();
+            }
+        }
+        resetCamera();
+        updateVisibleRange();
+        syncTiles();
         positionButtons();
         positionCounter();
         positionTimer();
-        placeMines();
-        remainingMines = mines;
         updateCounter();
+
+        leaderboardWindow.reset(new LeaderboardWindow(width, boardAreaHeight() / 2 + 50));
+        leaderboardStore.request(cols, rows, mines); // So the first open is instant
     }
 
 
 
 
 
-    void run() override {
-        while (window.isOpen()) {
-            sf::Event event;
-            while (window.pollEvent(event)) {
-                handleInput(event);
-            }
-
-            window.clear(sf::Color::White);
-
-            // Update the timer only if not paused and game is ongoing
-            if (!paused && !gameOver) {
-                updateTimer();
-            }
-
-            // Draw the game tiles
-            for (const auto &row : tiles) {
-                for (const auto &tile : row) {
-                    tile.draw(window);
-
-                    // Draw debug information only if not paused and debug mode is active
-                    if (!paused && debugMode && tile.hasMine()) {
-                        sf::Sprite mineSprite;
-                        mineSprite.setTexture(mineTexture);
-                        mineSprite.setPosition(tile.getPosition());
-                        window.draw(mineSprite);
-                    }
-                }
-            }
+    void handleEvent(sf::Event &event) override {
+        // Only handling is timed; waiting for the next event is idle
+        if (isMouseInput(event)) frameStats.inputDequeued();
+        frameStats.begin();
+        handleInput(event);
+        frameStats.end(FrameStats::Events);
+    }
 
-            // Draw the timer
-            for (const auto &sprite : timerMinutesSprites) {
-                window.draw(sprite);
-            }
-            for (const auto &sprite : timerSecondsSprites) {
-                window.draw(sprite);
-            }
+    void drawFrame() override {
+        // Update the timer only if not paused and game is ongoing,
+        // and wake up again when the displayed second changes
+        frameStats.begin();
+        if (replaying && !paused && !gameOver) advanceReplay();
+        if (!paused && !gameOver) {
+            updateTimer();
+            int untilNextSecond = 1000 - gameTime().asMilliseconds() % 1000;
+            scheduler.redrawIn(sf::milliseconds(static_cast<sf::Int32>(untilNextSecond / (replaying ? replaySpeed : 1.0f)) + 1));
+        }
+        updateVisibleRange();
+        pollLeaderboard();
+        frameStats.end(FrameStats::Update);
+
+        // Draw the visible game tiles in a single call
+        frameStats.begin();
+        window.clear(sf::Color::White);
+        window.setView(boardView);
+        // While paused the renderer draws a single blank cover instead
+        boardRenderer.draw(window);
+        if (!paused) drawProbabilityLabels();
+
+        // The HUD stays fixed regardless of the camera
+        window.setView(hudView);
+
+        // Draw the timer
+        for (const auto &sprite : timerMinutesSprites) {
+            window.draw(sprite);
+        }
+        for (const auto &sprite : timerSecondsSprites) {
+            window.draw(sprite);
+        }
 
-            // Draw the counter and buttons
-            for (const auto &sprite : counterSprites) {
-                window.draw(sprite);
-            }
-            window.draw(happyFaceButton);
-            window.draw(debugButton);
-            window.draw(playButton);
-            window.draw(leaderboardButton);
+        // Draw the counter and buttons
+        for (const auto &sprite : counterSprites) {
+            window.draw(sprite);
+        }
+        window.draw(happyFaceButton);
+        window.draw(debugButton);
+        if (!infiniteMode) window.draw(probabilityButton);
+        window.draw(playButton);
+        window.draw(leaderboardButton);
+        drawFrameStats();
+        frameStats.end(FrameStats::Draw);
+
+        frameStats.begin();
+        window.display();
+        frameStats.end(FrameStats::Display);
+        frameStats.frameDisplayed();
+        if (scheduler.getFramesDrawn() == 0) AssetManager::shared().logFirstFrame("Game window");
+    }
 
-            window.display();
+    // The game and leaderboard windows share one loop until the game's closes
+    void run() override {
+        WindowDispatcher dispatcher;
+        dispatcher.add(*this);
+        dispatcher.add(*leaderboardWindow);
+        dispatcher.run();
+
+        // An unfinished game is saved to resume; anything else goes to the
+        // replay archive
+        if (!autosave()) finishRecording();
+        cout << "Frames drawn: " << scheduler.getFramesDrawn()
+             << ", last CPU usage: " << scheduler.getCpuUsage() << "%" << endl;
+        if (frameCsv) {
+            if (frameStats.writeCsv("frame_stats.csv")) cout << "Frame timings written to frame_stats.csv" << endl;
+            else cerr << "Error: Could not write frame_stats.csv" << endl;
         }
     }
 
@@ -843,27 +1184,61 @@ public:
 
 
 int main() {
+    // Decode every image on worker threads while the windows are created
+    AssetManager &assets = AssetManager::shared();
+    vector<string> images;
+    for (const char *name : {"tile_hidden", "tile_revealed", "flag", "mine", "digits", "face_happy", "face_win",
+                             "face_lose", "debug", "play", "pause", "leaderboard"}) {
+        images.push_back(string("files/images/") + name + ".png");
+    }
+    for (int i = 1; i <= 8; ++i) images.push_back("files/images/number_" + to_string(i) + ".png");
+    assets.preload(images);
+
     const std::string configPath = "files/config.cfg";
 
     int cols, rows;
-    ifstream configFile(configPath);
-    if (!configFile) {
+    istringstream configFile;
+    try {
+        configFile.str(assets.file(configPath)); // GameWindow parses the same copy
+    } catch (const runtime_error &) {
         cerr << "Error: Could not open config file.\n";
         return -1;
     }
-    configFile >> cols >> rows;
-    configFile.close();
+    // "infinite" boards have no size; they get the largest window
+    string first;
+    configFile >> first;
+    if (first == "infinite") {
+        cols = rows = 1000000;
+    } else {
+        // GameWindow reports anything else wrong with the config
+        istringstream number(first);
+        if (!(number >> cols) || !number.eof() || !(configFile >> rows)) {
+            cerr << "Error: Config needs \"cols rows mines\" or \"infinite density\"\n";
+            return -1;
+        }
+    }
 
-    int width = cols * 32;
-    int height = rows * 32 + 100;
+    // Boards larger than the screen get a screen-sized window; the camera
+    // zooms and pans over the rest
+    sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+    int width = min(cols * 32, static_cast<int>(desktop.width) * 9 / 10);
+    int height = min(rows * 32, static_cast<int>(desktop.height) * 9 / 10 - 100) + 100;
 
     WelcomeWindow welcomeWindow(width, height);
     welcomeWindow.run();
 
     if (welcomeWindow.shouldLaunch()) {
         std::string playerName = welcomeWindow.getPlayerName(); // Retrieve the player's name
-        GameWindow gameWindow(configPath, width, height, playerName); // Pass the name to GameWindow
-        gameWindow.run();
+        assets.startTimer();
+        // A bad config is reported, not left to abort the game
+        unique_ptr<GameWindow> gameWindow;
+        try {
+            gameWindow.reset(new GameWindow(configPath, width, height, playerName)); // Pass the name to GameWindow
+        } catch (const runtime_error &e) {
+            cerr << "Error: " << e.what() << "\n";
+            return -1;
+        }
+        gameWindow->run();
     }
 
     return 0;
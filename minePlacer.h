@@ -0,0 +1,71 @@
+#ifndef MINEPLACER_H
+#define MINEPLACER_H
+
+#include <vector>
+#include <algorithm>
+#include "board.h"
+#include "rng.h"
+using namespace std;
+
+// Places mines with Floyd's sampling over the dense cell numbering (see
+// Board::indexOfNth): exactly one random draw per mine and no rejection
+// loop, so cost is O(mines) at any density.
+class MinePlacer {
+private:
+    // Map an index in the "allowed" space onto a dense cell number,
+    // skipping the sorted excluded ones
+    static int toCell(int k, const vector<int> &excluded) {
+        for (int e : excluded) {
+            if (e <= k) k++;
+            else break;
+        }
+        return k;
+    }
+
+public:
+    // Place mines anywhere on the board
+    static void place(Board &board, int mines, FastRng &rng, vector<int> *placed = nullptr) {
+        place(board, mines, rng, vector<int>(), placed);
+    }
+
+    // Place mines on every cell except those listed in excluded (cell
+    // indices). The chosen cells are appended to placed when it is given.
+    static void place(Board &board, int mines, FastRng &rng, vector<int> excluded, vector<int> *placed) {
+        for (int &e : excluded) e = board.ordinalOf(e);
+        sort(excluded.begin(), excluded.end());
+        excluded.erase(unique(excluded.begin(), excluded.end()), excluded.end());
+
+        int allowed = board.size() - static_cast<int>(excluded.size());
+        mines = min(mines, allowed);
+
+        // Floyd: for j in [allowed - mines, allowed), pick t in [0, j];
+        // if t is taken, take j instead (j has never been offered before)
+        for (int j = allowed - mines; j < allowed; ++j) {
+            int t = static_cast<int>(rng.below(static_cast<uint32_t>(j + 1)));
+            int cell = board.indexOfNth(toCell(t, excluded));
+            if (board.isMine(cell)) cell = board.indexOfNth(toCell(j, excluded));
+            board.setMine(cell);
+            if (placed) placed->push_back(cell);
+        }
+
+        board.computeAdjacentCounts();
+    }
+
+    // Place mines keeping (row, col) and, where the density allows, its
+    // neighbors free so the first click always opens safely
+    static void placeAvoiding(Board &board, int mines, FastRng &rng, int row, int col,
+                              vector<int> *placed = nullptr) {
+        vector<int> excluded;
+        board.neighbors(row, col, excluded);
+        excluded.push_back(board.index(row, col));
+
+        if (mines >= board.size()) {
+            excluded.clear(); // Every cell is a mine, nothing can be kept free
+        } else if (mines > board.size() - static_cast<int>(excluded.size())) {
+            excluded.assign(1, board.index(row, col));
+        }
+        place(board, mines, rng, excluded, placed);
+    }
+};
+
+#endif //MINEPLACER_H
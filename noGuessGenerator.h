@@ -0,0 +1,146 @@
+#ifndef NOGUESSGENERATOR_H
+#define NOGUESSGENERATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include "gameEngine.h"
+#include "solver.h"
+using namespace std;
+
+// Finds boards that can be won from a given first click without guessing.
+// Candidate boards come from a fixed sequence of seeds derived from a base
+// seed; a pool of workers plays them with the Solver in parallel and the
+// lowest-numbered candidate that passes wins. The result therefore depends
+// only on the base seed and the click, never on thread timing.
+class NoGuessGenerator {
+private:
+    struct Job {
+        int cols = 0, rows = 0, mines = 0;
+        int row = 0, col = 0;
+        uint64_t baseSeed = 0;
+        size_t maxCandidates = 0;
+    };
+
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake;      // New job or shutdown
+    condition_variable finished;  // Every worker is done with the job
+    Job job;
+    unsigned long jobNumber = 0;
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+
+    atomic<size_t> nextCandidate{0};
+    atomic<size_t> bestCandidate{0};  // Lowest passing candidate so far
+    atomic<size_t> candidatesTried{0};
+
+    double lastMillis = 0;
+    size_t lastCandidates = 0;
+
+    void lowerBest(size_t candidate) {
+        size_t best = bestCandidate.load();
+        while (candidate < best && !bestCandidate.compare_exchange_weak(best, candidate)) {
+        }
+    }
+
+    void work() {
+        GameEngine engine;
+        Solver solver;
+        unsigned long seenJob = 0;
+        while (true) {
+            Job current;
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || jobNumber != seenJob; });
+                if (stopping) return;
+                seenJob = jobNumber;
+                current = job;
+            }
+
+            if (engine.getCols() != current.cols || engine.getRows() != current.rows ||
+                engine.getMines() != current.mines) {
+                engine.configure(current.cols, current.rows, current.mines);
+                engine.setFirstClickSafe(true);
+            }
+
+            // Candidates are handed out in order, so once one passes every
+            // lower one has already been taken and the search can stop
+            for (size_t i = nextCandidate++; i < current.maxCandidates && i < bestCandidate.load(); i = nextCandidate++) {
+                engine.reset(candidateSeed(current.baseSeed, i));
+                candidatesTried++;
+                if (solver.play(engine, current.row, current.col)) lowerBest(i);
+            }
+
+            unique_lock<mutex> guard(lock);
+            if (--busyWorkers == 0) finished.notify_all();
+        }
+    }
+
+public:
+    explicit NoGuessGenerator(unsigned threads = thread::hardware_concurrency()) {
+        threads = max(1u, threads);
+        for (unsigned t = 0; t < threads; ++t) workers.emplace_back([this] { work(); });
+    }
+
+    ~NoGuessGenerator() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread &worker : workers) worker.join();
+    }
+
+    NoGuessGenerator(const NoGuessGenerator &) = delete;
+    NoGuessGenerator &operator=(const NoGuessGenerator &) = delete;
+
+    // Seed of candidate i in the sequence for baseSeed; candidate 0 is the
+    // base seed itself
+    static uint64_t candidateSeed(uint64_t baseSeed, size_t i) {
+        return i == 0 ? baseSeed : FastRng(baseSeed ^ (i * 0x9E3779B97F4A7C15ULL)).next();
+    }
+
+    // Search for a no-guess board opened at (row, col) by a first-click-safe
+    // GameEngine. On success seed holds the board seed and true is returned;
+    // if none of the first maxCandidates passes, seed is the base seed.
+    bool generate(int cols, int rows, int mines, int row, int col, uint64_t baseSeed, uint64_t &seed,
+                  size_t maxCandidates = 2000) {
+        auto start = chrono::steady_clock::now();
+        {
+            unique_lock<mutex> guard(lock);
+            job.cols = cols;
+            job.rows = rows;
+            job.mines = mines;
+            job.row = row;
+            job.col = col;
+            job.baseSeed = baseSeed;
+            job.maxCandidates = maxCandidates;
+            nextCandidate = 0;
+            bestCandidate = maxCandidates;
+            candidatesTried = 0;
+            busyWorkers = static_cast<unsigned>(workers.size());
+            jobNumber++;
+            wake.notify_all();
+            finished.wait(guard, [&] { return busyWorkers == 0; });
+        }
+
+        lastMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        lastCandidates = candidatesTried.load();
+        bool found = bestCandidate.load() < maxCandidates;
+        seed = found ? candidateSeed(baseSeed, bestCandidate.load()) : baseSeed;
+        return found;
+    }
+
+    // Statistics of the last generate call
+    double getLastMillis() const { return lastMillis; }
+    size_t getLastCandidates() const { return lastCandidates; }
+    unsigned getThreadCount() const { return static_cast<unsigned>(workers.size()); }
+};
+
+#endif //NOGUESSGENERATOR_H
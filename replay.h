@@ -0,0 +1,220 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "gameEngine.h"
+using namespace std;
+
+// LEB128 unsigned varints: 7 bits per byte, high bit set on all but the last
+struct Varint {
+    static void put(vector<uint8_t> &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t get(const uint8_t *&p, const uint8_t *end) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) throw runtime_error("Truncated varint");
+            uint8_t byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        throw runtime_error("Varint too long");
+    }
+};
+
+enum class ReplayAction : uint8_t { Reveal = 0, Flag = 1, Chord = 2 };
+
+struct ReplayMove {
+    uint32_t millis;     // Game time of the move; paused time is excluded
+    ReplayAction action;
+    int row, col;
+};
+
+// One recorded game: the board seed and config, then every move that
+// changed the board. Moves are stored as (delta millis, cell * 4 + action)
+// varint pairs, usually four bytes per move. Games are appended to a
+// single archive, each behind a "MSR" magic, a version byte and its length
+// so readers can skip what they don't understand.
+struct Replay {
+    static const uint8_t version = 1;
+
+    int cols = 0, rows = 0, mines = 0;
+    bool firstClickSafe = true;
+    uint64_t seed = 0;   // The seed actually used, after any no-guess search
+    string player;
+    vector<ReplayMove> moves;
+
+    void encode(vector<uint8_t> &out) const {
+        vector<uint8_t> payload;
+        Varint::put(payload, static_cast<uint64_t>(cols));
+        Varint::put(payload, static_cast<uint64_t>(rows));
+        Varint::put(payload, static_cast<uint64_t>(mines));
+        payload.push_back(firstClickSafe ? 1 : 0);
+        for (int i = 0; i < 8; ++i) payload.push_back(static_cast<uint8_t>(seed >> (8 * i)));
+        Varint::put(payload, player.size());
+        payload.insert(payload.end(), player.begin(), player.end());
+
+        Varint::put(payload, moves.size());
+        uint32_t last = 0;
+        for (const ReplayMove &move : moves) {
+            Varint::put(payload, move.millis - last);
+            uint64_t cell = static_cast<uint64_t>(move.row) * cols + move.col;
+            Varint::put(payload, cell * 4 + static_cast<uint8_t>(move.action));
+            last = move.millis;
+        }
+
+        out.push_back('M');
+        out.push_back('S');
+        out.push_back('R');
+        out.push_back(version);
+        Varint::put(out, payload.size());
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    // Decode the game at p and advance past it. Throws on corrupt data;
+    // returns false for a game written by a newer version (p still advances).
+    bool decode(const uint8_t *&p, const uint8_t *end) {
+        if (end - p < 4 || p[0] != 'M' || p[1] != 'S' || p[2] != 'R') throw runtime_error("Not a replay");
+        uint8_t gameVersion = p[3];
+        p += 4;
+        uint64_t length = Varint::get(p, end);
+        if (length > static_cast<uint64_t>(end - p)) throw runtime_error("Truncated replay");
+        const uint8_t *next = p + length;
+        if (gameVersion != version) {
+            p = next;
+            return false;
+        }
+
+        uint64_t c = Varint::get(p, next), r = Varint::get(p, next), m = Varint::get(p, next);
+        if (c == 0 || r == 0 || c > 1u << 15 || r > 1u << 15 || m > c * r) throw runtime_error("Corrupt replay config");
+        cols = static_cast<int>(c);
+        rows = static_cast<int>(r);
+        mines = static_cast<int>(m);
+        if (next - p < 9) throw runtime_error("Truncated replay");
+        firstClickSafe = *p++ != 0;
+        seed = 0;
+        for (int i = 0; i < 8; ++i) seed |= static_cast<uint64_t>(*p++) << (8 * i);
+        uint64_t nameLength = Varint::get(p, next);
+        if (nameLength > static_cast<uint64_t>(next - p)) throw runtime_error("Truncated replay");
+        player.assign(reinterpret_cast<const char *>(p), static_cast<size_t>(nameLength));
+        p += nameLength;
+
+        uint64_t count = Varint::get(p, next);
+        if (count > static_cast<uint64_t>(next - p) / 2) throw runtime_error("Corrupt replay move count");
+        moves.clear();
+        moves.reserve(static_cast<size_t>(count));
+        uint64_t millis = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            millis += Varint::get(p, next);
+            uint64_t packed = Varint::get(p, next);
+            uint64_t cell = packed / 4;
+            if (millis > UINT32_MAX || (packed & 3) == 3 || cell >= c * r) throw runtime_error("Corrupt replay move");
+            moves.push_back({static_cast<uint32_t>(millis), static_cast<ReplayAction>(packed & 3),
+                             static_cast<int>(cell / c), static_cast<int>(cell % c)});
+        }
+        if (p != next) throw runtime_error("Corrupt replay length");
+        return true;
+    }
+
+    // Add this game to the end of an archive file
+    void append(const string &path) const {
+        vector<uint8_t> bytes;
+        encode(bytes);
+        ofstream file(path, ios::binary | ios::app);
+        if (!file) throw runtime_error("Unable to open " + path);
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<streamsize>(bytes.size()));
+        if (!file) throw runtime_error("Unable to write " + path);
+    }
+
+    // Every game in an archive, oldest first. A missing file is empty. A
+    // damaged game (say, a write cut short) ends the archive there.
+    static vector<Replay> loadAll(const string &path) {
+        vector<Replay> games;
+        ifstream file(path, ios::binary);
+        if (!file) return games;
+        vector<uint8_t> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        const uint8_t *p = bytes.data(), *end = p + bytes.size();
+        try {
+            while (p != end) {
+                Replay game;
+                if (game.decode(p, end)) games.push_back(move(game));
+            }
+        } catch (const runtime_error &e) {
+            cerr << "Warning: " << path << " is damaged after game " << games.size() << ": " << e.what() << "\n";
+        }
+        return games;
+    }
+};
+
+// Replays a recorded game through GameEngine, either move by move as game
+// time passes (for real-time or N-times playback in a window) or all at
+// once with no rendering (for bulk verification).
+class ReplayPlayer {
+private:
+    const Replay *replay = nullptr;
+    size_t next = 0;
+
+public:
+    struct Outcome {
+        GameState state = GameState::Playing; // Playing: abandoned mid-game
+        uint32_t millis = 0;                  // Game time of the last move
+        size_t moves = 0;
+        size_t ignored = 0;                   // Moves that changed nothing
+    };
+
+    // Set up engine for the recorded board. The engine's seed picker must
+    // be unset: the recorded seed is already the one that was picked.
+    void start(const Replay &game, GameEngine &engine) {
+        replay = &game;
+        next = 0;
+        engine.configure(game.cols, game.rows, game.mines);
+        engine.setFirstClickSafe(game.firstClickSafe);
+        engine.reset(game.seed);
+    }
+
+    // The next move due by game time millis, or null; advances past it
+    const ReplayMove *due(uint32_t millis) {
+        if (finished() || replay->moves[next].millis > millis) return nullptr;
+        return &replay->moves[next++];
+    }
+
+    bool finished() const { return !replay || next == replay->moves.size(); }
+    uint32_t nextMillis() const { return finished() ? 0 : replay->moves[next].millis; }
+
+    // Returns true if the move changed the board
+    static bool apply(GameEngine &engine, const ReplayMove &move) {
+        switch (move.action) {
+            case ReplayAction::Reveal: return engine.reveal(move.row, move.col);
+            case ReplayAction::Flag: return engine.flag(move.row, move.col);
+            case ReplayAction::Chord: return engine.chord(move.row, move.col);
+        }
+        return false;
+    }
+
+    // Instant playback: every move, no timing, no rendering
+    static Outcome run(const Replay &game, GameEngine &engine) {
+        ReplayPlayer player;
+        player.start(game, engine);
+        Outcome outcome;
+        while (const ReplayMove *move = player.due(UINT32_MAX)) {
+            if (!apply(engine, *move)) outcome.ignored++;
+            outcome.moves++;
+            outcome.millis = move->millis;
+        }
+        outcome.state = engine.getState();
+        return outcome;
+    }
+};
+
+#endif //REPLAY_H
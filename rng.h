@@ -0,0 +1,63 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <random>
+using namespace std;
+
+// xoshiro256** generator: a few cycles per number, 256 bits of state,
+// fully determined by a 64-bit seed so boards can be reproduced.
+class FastRng {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitMix(uint64_t &x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit FastRng(uint64_t seedValue = 0) { seed(seedValue); }
+
+    void seed(uint64_t seedValue) {
+        for (auto &word : s) word = splitMix(seedValue);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Unbiased integer in [0, bound) using Lemire's multiply-shift
+    uint32_t below(uint32_t bound) {
+        uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Nondeterministic seed for when the caller doesn't supply one
+    static uint64_t randomSeed() {
+        random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }
+};
+
+#endif //RNG_H
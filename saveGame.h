@@ -0,0 +1,138 @@
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "atomicFile.h"
+#include "gameEngine.h"
+#include "replay.h"
+using namespace std;
+
+// Snapshot of an in-progress game: a fixed header, then the board's padded
+// grid exactly as Board stores it, then the game's replay so far. Loading
+// maps the file and copies the grid in one go, so even huge boards restore
+// without touching cells one by one. Fields are little-endian, as on every
+// platform the game targets.
+class SaveGame {
+public:
+    static const uint32_t version = 1;
+
+private:
+    enum : uint32_t { FirstClickSafe = 1, MinesPlaced = 2 };
+
+    struct Header {
+        char magic[4];         // "MSSV"
+        uint32_t version;
+        uint64_t checksum;     // Of every byte after this field
+        uint32_t headerSize;   // Where the grid starts
+        uint32_t flags;
+        int32_t cols, rows, mines;
+        uint32_t elapsedMillis; // Game time played, pauses excluded
+        uint64_t seed;
+        uint64_t cellBytes;
+        uint64_t replayBytes;
+    };
+    static_assert(sizeof(Header) == 64, "Save header layout changed");
+
+    static const size_t checksumEnd = 16; // magic, version, checksum
+
+    // Word-at-a-time multiply-xorshift hash; catches torn or damaged files
+    static uint64_t checksum(const uint8_t *p, size_t n) {
+        const uint64_t prime = 0xFF51AFD7ED558CCDULL;
+        uint64_t h = 0x9E3779B97F4A7C15ULL ^ n;
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            h = (h ^ word) * prime;
+            h ^= h >> 32;
+        }
+        for (; n > 0; ++p, --n) h = (h ^ *p) * prime;
+        h ^= h >> 33;
+        return h * 0xC4CEB9FE1A85EC53ULL;
+    }
+
+public:
+    // Write the game atomically; throws runtime_error on failure
+    static void save(const string &path, const GameEngine &engine, uint32_t elapsedMillis, const Replay &recording) {
+        const Board &board = engine.getBoard();
+        // The recording gets its board config when the game ends; give it
+        // one now so it decodes on its own
+        Replay game = recording;
+        game.cols = engine.getCols();
+        game.rows = engine.getRows();
+        game.mines = engine.getMines();
+        game.firstClickSafe = engine.isFirstClickSafe();
+        game.seed = engine.getSeed();
+        vector<uint8_t> replayBytes;
+        game.encode(replayBytes);
+
+        Header header;
+        memcpy(header.magic, "MSSV", 4);
+        header.version = version;
+        header.checksum = 0;
+        header.headerSize = sizeof(Header);
+        header.flags = 0;
+        if (engine.isFirstClickSafe()) header.flags |= FirstClickSafe;
+        if (engine.areMinesPlaced()) header.flags |= MinesPlaced;
+        header.cols = engine.getCols();
+        header.rows = engine.getRows();
+        header.mines = engine.getMines();
+        header.elapsedMillis = elapsedMillis;
+        header.seed = engine.getSeed();
+        header.cellBytes = board.byteSize();
+        header.replayBytes = replayBytes.size();
+
+        vector<uint8_t> bytes(sizeof(Header) + board.byteSize() + replayBytes.size());
+        memcpy(bytes.data() + sizeof(Header), board.data(), board.byteSize());
+        if (!replayBytes.empty()) {
+            memcpy(bytes.data() + sizeof(Header) + board.byteSize(), replayBytes.data(), replayBytes.size());
+        }
+        memcpy(bytes.data(), &header, sizeof(Header));
+        header.checksum = checksum(bytes.data() + checksumEnd, bytes.size() - checksumEnd);
+        memcpy(bytes.data(), &header, sizeof(Header));
+
+        writeFileAtomically(path, bytes.data(), bytes.size());
+    }
+
+    // Restore a saved game into engine. Returns false if there is no save;
+    // throws runtime_error if it is damaged or from another version.
+    static bool load(const string &path, GameEngine &engine, uint32_t &elapsedMillis, Replay &recording) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        const uint8_t *bytes = file.data();
+        size_t size = file.size();
+
+        Header header;
+        if (size < sizeof(Header)) throw runtime_error("Save file is truncated");
+        memcpy(&header, bytes, sizeof(Header));
+        if (memcmp(header.magic, "MSSV", 4) != 0) throw runtime_error("Not a save file");
+        if (header.version != version) throw runtime_error("Unsupported save version " + to_string(header.version));
+        if (checksum(bytes + checksumEnd, size - checksumEnd) != header.checksum) {
+            throw runtime_error("Save file checksum mismatch");
+        }
+
+        uint64_t expectedCells = (static_cast<uint64_t>(header.rows) + 2) * (static_cast<uint64_t>(header.cols) + 2);
+        if (header.cols <= 0 || header.rows <= 0 || header.cellBytes != expectedCells ||
+            header.headerSize < sizeof(Header) ||
+            header.headerSize + header.cellBytes + header.replayBytes != size) {
+            throw runtime_error("Save file sizes are inconsistent");
+        }
+
+        const uint8_t *cells = bytes + header.headerSize;
+        engine.restore(header.cols, header.rows, header.mines, header.seed, (header.flags & FirstClickSafe) != 0,
+                       (header.flags & MinesPlaced) != 0, cells);
+        elapsedMillis = header.elapsedMillis;
+
+        recording = Replay();
+        if (header.replayBytes > 0) {
+            const uint8_t *p = cells + header.cellBytes;
+            recording.decode(p, p + header.replayBytes);
+        }
+        return true;
+    }
+};
+
+#endif //SAVEGAME_H
@@ -0,0 +1,532 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <cmath>
+#include "board.h"
+#include "gameEngine.h"
+using namespace std;
+
+// Logic solver over what a player can see: revealed numbers and which
+// cells are still hidden. Mine bits of hidden cells are never read, and
+// flags are ignored since they may be wrong.
+//
+// Deductions run cheapest first: the single-cell rule on each number, then
+// the pairwise subset rule between numbers up to two cells apart, and only
+// when both stall an exact enumeration of every consistent mine layout on
+// each connected piece of the frontier.
+class Solver {
+public:
+    struct Result {
+        vector<int> safe;          // Hidden cells proven safe (cell indices)
+        vector<int> mines;         // Hidden cells proven to be mines
+        // Hidden safe cells remain but none is provable. Conservative:
+        // enumeration doesn't weigh the mine total across components and
+        // the interior, so a few positions the total decides still say so.
+        bool guessNeeded = false;
+    };
+
+private:
+    enum Mark : uint8_t { Unknown, Safe, Mine };
+
+    // Layout counts of one frontier component, by mines in the component
+    struct ComponentCounts {
+        vector<int> cells;        // Cell indices
+        vector<double> ways;      // ways[k]: layouts with k mines
+        vector<double> cellWays;  // cellWays[k * cells + i]: those with cell i a mine
+        bool complete = false;    // False if the search ran out of budget
+    };
+
+    // Numbers whose unknown neighbors are being enumerated
+    struct Constraint {
+        int need;
+        int unassigned;
+        vector<int> cells; // Local cell ids within the component
+    };
+
+    const Board *board = nullptr;
+    int totalMines = -1;
+    Result result;
+    unsigned long long positions = 0;
+
+    vector<uint8_t> marks;   // Per cell index
+    vector<uint8_t> queued;  // Per cell index, numbers waiting in queue
+    vector<int> queue;       // Numbers to recheck with the single-cell rule
+    vector<int> active;      // Numbers with unknown neighbors
+
+    // Enumeration scratch, reused between components
+    size_t budget = 0;
+    vector<int> localId;     // Per cell index, -1 when not in the component
+    vector<int> parent;      // Union-find over frontier cells
+    vector<int> compCells;
+    vector<Constraint> compConstraints;
+    vector<vector<int>> cellConstraints;
+    vector<uint8_t> assignment;
+    vector<int> frontier;
+    vector<vector<int>> groups;
+    ComponentCounts scratch;
+    ComponentCounts *counts = nullptr;
+
+    // Counts of the components seen by the last probability pass, keyed by
+    // their numbers and unknown cells; any reveal touching one changes its key
+    map<vector<int>, ComponentCounts> cache;
+    vector<float> probabilities;
+
+    static const size_t enumerationBudget = 1 << 18; // Search nodes per component
+
+    // Unknown hidden neighbors of a revealed number, and how many of them
+    // must still be mines
+    int collect(int idx, int *unknown, int &need) const {
+        int count = 0;
+        need = board->adjacentMines(idx);
+        for (int i = 0; i < 8; ++i) {
+            int n = idx + board->neighborOffsets()[i];
+            if (board->isRevealed(n)) continue;
+            if (marks[n] == Mine) need--;
+            else if (marks[n] == Unknown) unknown[count++] = n;
+        }
+        return count;
+    }
+
+    void enqueue(int idx) {
+        if (queued[idx] || !board->isRevealed(idx) || board->isBorder(idx) || board->adjacentMines(idx) == 0) return;
+        queued[idx] = 1;
+        queue.push_back(idx);
+    }
+
+    bool mark(int idx, Mark value) {
+        if (marks[idx] != Unknown) return false;
+        marks[idx] = value;
+        (value == Safe ? result.safe : result.mines).push_back(idx);
+        for (int i = 0; i < 8; ++i) enqueue(idx + board->neighborOffsets()[i]);
+        return true;
+    }
+
+    // A number needing no more mines clears its unknowns; one needing all
+    // of them makes them all mines
+    bool propagateSingles() {
+        bool changed = false;
+        int unknown[8], need;
+        while (!queue.empty()) {
+            int idx = queue.back();
+            queue.pop_back();
+            queued[idx] = 0;
+            int count = collect(idx, unknown, need);
+            if (count == 0 || (need != 0 && need != count)) continue;
+            for (int i = 0; i < count; ++i) changed |= mark(unknown[i], need == 0 ? Safe : Mine);
+        }
+        return changed;
+    }
+
+    void gatherActive() {
+        active.clear();
+        int unknown[8], need;
+        for (int n = 0; n < board->size(); ++n) {
+            int idx = board->indexOfNth(n);
+            if (board->isRevealed(idx) && board->adjacentMines(idx) > 0 && collect(idx, unknown, need) > 0) {
+                active.push_back(idx);
+            }
+        }
+    }
+
+    // For numbers A and B: if B needs exactly |B \ A| more mines than A,
+    // then every cell of B \ A is a mine and every cell of A \ B is safe.
+    // With A inside B this is the usual subset rule. Each pair is visited
+    // once and tried in both directions.
+    bool applyPairs() {
+        bool changed = false;
+        int stride = board->getStride();
+        int unknownA[8], unknownB[8], needA, needB;
+        gatherActive();
+        for (int a : active) {
+            int countA = collect(a, unknownA, needA);
+            int row = board->rowOf(a), col = board->colOf(a);
+            for (int dr = 0; dr <= 2 && countA > 0; ++dr) {
+                for (int dc = -2; dc <= 2 && countA > 0; ++dc) {
+                    if ((dr == 0 && dc <= 0) || !board->inBounds(row + dr, col + dc)) continue;
+                    int b = a + dr * stride + dc;
+                    if (!board->isRevealed(b) || board->adjacentMines(b) == 0) continue;
+                    int countB = collect(b, unknownB, needB);
+                    if (countB == 0) continue;
+
+                    int onlyB[8], onlyA[8], nOnlyB = 0, nOnlyA = 0;
+                    for (int i = 0; i < countB; ++i) {
+                        if (find(unknownA, unknownA + countA, unknownB[i]) == unknownA + countA) onlyB[nOnlyB++] = unknownB[i];
+                    }
+                    for (int i = 0; i < countA; ++i) {
+                        if (find(unknownB, unknownB + countB, unknownA[i]) == unknownB + countB) onlyA[nOnlyA++] = unknownA[i];
+                    }
+                    if (nOnlyA + nOnlyB == 0) continue;
+
+                    int *mines = nullptr, *safe = nullptr, nMines = 0, nSafe = 0;
+                    if (needB - needA == nOnlyB) {
+                        mines = onlyB, nMines = nOnlyB, safe = onlyA, nSafe = nOnlyA;
+                    } else if (needA - needB == nOnlyA) {
+                        mines = onlyA, nMines = nOnlyA, safe = onlyB, nSafe = nOnlyB;
+                    } else {
+                        continue;
+                    }
+                    for (int i = 0; i < nMines; ++i) changed |= mark(mines[i], Mine);
+                    for (int i = 0; i < nSafe; ++i) changed |= mark(safe[i], Safe);
+                    countA = collect(a, unknownA, needA);
+                }
+            }
+        }
+        return changed;
+    }
+
+    // With the total known: no mines left clears every unknown cell, as
+    // many mines left as unknown cells makes them all mines
+    bool applyMineCount() {
+        if (totalMines < 0) return false;
+        int knownMines = 0, unknownCells = 0;
+        for (int n = 0; n < board->size(); ++n) {
+            int idx = board->indexOfNth(n);
+            if (board->isRevealed(idx)) continue;
+            if (marks[idx] == Mine) knownMines++;
+            else if (marks[idx] == Unknown) unknownCells++;
+        }
+        int left = totalMines - knownMines;
+        if (unknownCells == 0 || (left != 0 && left != unknownCells)) return false;
+        bool changed = false;
+        for (int n = 0; n < board->size(); ++n) {
+            int idx = board->indexOfNth(n);
+            if (!board->isRevealed(idx) && marks[idx] == Unknown) changed |= mark(idx, left == 0 ? Safe : Mine);
+        }
+        return changed;
+    }
+
+    int findRoot(int x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    }
+
+    // Depth-first over the component's cells in order, pruning as soon as
+    // a number can no longer be satisfied, tallying complete layouts by
+    // their mine count. False once the budget is spent.
+    bool search(size_t cell, int placed) {
+        if (++budget > enumerationBudget) return false;
+        size_t n = compCells.size();
+        if (cell == n) {
+            counts->ways[placed] += 1;
+            double *row = &counts->cellWays[placed * n];
+            for (size_t i = 0; i < n; ++i) row[i] += assignment[i];
+            return true;
+        }
+        for (int value = 0; value <= 1; ++value) {
+            bool feasible = true;
+            for (int c : cellConstraints[cell]) {
+                Constraint &constraint = compConstraints[c];
+                constraint.unassigned--;
+                constraint.need -= value;
+                if (constraint.need < 0 || constraint.need > constraint.unassigned) feasible = false;
+            }
+            assignment[cell] = static_cast<uint8_t>(value);
+            bool withinBudget = !feasible || search(cell + 1, placed + value);
+            for (int c : cellConstraints[cell]) {
+                compConstraints[c].unassigned++;
+                compConstraints[c].need += value;
+            }
+            if (!withinBudget) return false;
+        }
+        return true;
+    }
+
+    // Split the numbers with unknown neighbors into groups that share no
+    // unknown cell; each group is enumerated on its own
+    void buildComponents() {
+        gatherActive();
+        frontier.clear();
+        int unknown[8], need;
+        for (int a : active) {
+            int count = collect(a, unknown, need);
+            for (int i = 0; i < count; ++i) {
+                if (localId[unknown[i]] >= 0) continue;
+                localId[unknown[i]] = static_cast<int>(frontier.size());
+                frontier.push_back(unknown[i]);
+            }
+        }
+        parent.resize(frontier.size());
+        for (size_t i = 0; i < frontier.size(); ++i) parent[i] = static_cast<int>(i);
+        for (int a : active) {
+            int count = collect(a, unknown, need);
+            for (int i = 1; i < count; ++i) {
+                parent[findRoot(localId[unknown[i]])] = findRoot(localId[unknown[0]]);
+            }
+        }
+
+        // Group the numbers by the component of their first unknown
+        groups.assign(frontier.size(), vector<int>());
+        for (int a : active) {
+            collect(a, unknown, need);
+            groups[findRoot(localId[unknown[0]])].push_back(a);
+        }
+        for (int f : frontier) localId[f] = -1;
+        groups.erase(remove_if(groups.begin(), groups.end(),
+                               [](const vector<int> &group) { return group.empty(); }), groups.end());
+    }
+
+    // Count every consistent layout of one group's unknown cells into out
+    void enumerateGroup(const vector<int> &group, ComponentCounts &out) {
+        // Cells are numbered in the order the numbers reach them, so
+        // neighboring cells sit close together in the search
+        int unknown[8], need;
+        compCells.clear();
+        compConstraints.clear();
+        for (int a : group) {
+            int count = collect(a, unknown, need);
+            Constraint constraint{need, count, vector<int>()};
+            for (int i = 0; i < count; ++i) {
+                if (localId[unknown[i]] < 0) {
+                    localId[unknown[i]] = static_cast<int>(compCells.size());
+                    compCells.push_back(unknown[i]);
+                }
+                constraint.cells.push_back(localId[unknown[i]]);
+            }
+            compConstraints.push_back(constraint);
+        }
+        size_t n = compCells.size();
+        cellConstraints.assign(n, vector<int>());
+        for (size_t c = 0; c < compConstraints.size(); ++c) {
+            for (int cell : compConstraints[c].cells) cellConstraints[cell].push_back(static_cast<int>(c));
+        }
+        assignment.assign(n, 0);
+
+        out.cells = compCells;
+        out.ways.assign(n + 1, 0);
+        out.cellWays.assign((n + 1) * n, 0);
+        counts = &out;
+        budget = 0;
+        out.complete = search(0, 0);
+        for (int cell : compCells) localId[cell] = -1;
+    }
+
+    // Enumerate every consistent layout of each frontier component; cells
+    // that are a mine in none of them are safe, in all of them a mine.
+    // Components too large for the budget are left undecided.
+    bool enumerateFrontier() {
+        buildComponents();
+        bool changed = false;
+        for (const vector<int> &group : groups) {
+            enumerateGroup(group, scratch);
+            if (!scratch.complete) continue;
+
+            size_t n = scratch.cells.size();
+            double solutions = 0;
+            for (double ways : scratch.ways) solutions += ways;
+            if (solutions == 0) continue;
+            for (size_t i = 0; i < n; ++i) {
+                double mineWays = 0;
+                for (size_t k = 0; k <= n; ++k) mineWays += scratch.cellWays[k * n + i];
+                if (mineWays == 0) changed |= mark(scratch.cells[i], Safe);
+                else if (mineWays == solutions) changed |= mark(scratch.cells[i], Mine);
+            }
+        }
+        return changed;
+    }
+
+    static vector<double> convolve(const vector<double> &a, const vector<double> &b) {
+        vector<double> out(a.size() + b.size() - 1, 0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] == 0) continue;
+            for (size_t j = 0; j < b.size(); ++j) out[i + j] += a[i] * b[j];
+        }
+        return out;
+    }
+
+    static double logChoose(int n, int k) {
+        return lgamma(n + 1.0) - lgamma(k + 1.0) - lgamma(n - k + 1.0);
+    }
+
+    // Run the rules, keeping marks from earlier calls. With untilSafe the
+    // costlier rules are skipped once any safe cell is known; otherwise
+    // every rule, enumeration included, runs until none marks anything new.
+    void deduce(bool untilSafe) {
+        positions++;
+        result.safe.clear();
+        result.mines.clear();
+
+        while (true) {
+            propagateSingles();
+            if (untilSafe && !result.safe.empty()) break;
+            if (applyPairs() || applyMineCount()) continue;
+            if (!enumerateFrontier()) break;
+        }
+        propagateSingles();
+
+        result.guessNeeded = false;
+        if (result.safe.empty()) {
+            for (int n = 0; n < board->size() && !result.guessNeeded; ++n) {
+                int idx = board->indexOfNth(n);
+                result.guessNeeded = !board->isRevealed(idx) && marks[idx] != Mine;
+            }
+        }
+    }
+
+    void start(const Board &target, int mines) {
+        board = &target;
+        totalMines = mines;
+        size_t cells = static_cast<size_t>(target.getRows() + 2) * target.getStride();
+        marks.assign(cells, Unknown);
+        queued.assign(cells, 0);
+        localId.assign(cells, -1);
+        queue.clear();
+        for (int n = 0; n < target.size(); ++n) enqueue(target.indexOfNth(n));
+    }
+
+public:
+    // Every safe cell and mine the rules prove on board right now, run to
+    // a fixed point. totalMines enables the mine count rule; pass -1 when
+    // the total is not known.
+    const Result &analyze(const Board &target, int mines = -1) {
+        start(target, mines);
+        deduce(false);
+        return result;
+    }
+
+    // Play engine from its first click using only proven moves. Returns
+    // true if the game is won without ever having to guess.
+    bool play(GameEngine &engine, int row, int col) {
+        engine.reveal(row, col);
+        start(engine.getBoard(), engine.getMines());
+        while (engine.getState() == GameState::Playing) {
+            deduce(true);
+            if (result.safe.empty()) return false;
+            for (int idx : result.safe) {
+                if (!engine.reveal(board->rowOf(idx), board->colOf(idx))) continue;
+                // New numbers, and numbers that lost an unknown neighbor
+                for (int changed : engine.getChangedCells()) {
+                    enqueue(changed);
+                    for (int i = 0; i < 8; ++i) enqueue(changed + board->neighborOffsets()[i]);
+                }
+            }
+        }
+        return engine.hasWon();
+    }
+
+    // Exact chance that each hidden cell is a mine, given the revealed
+    // numbers and the mine total, indexed by cell index. Frontier
+    // components are enumerated separately (or reused from the last call
+    // if untouched) and combined with the binomial count of placements in
+    // the unconstrained interior. Revealed cells get -1, as do the cells
+    // of a component too large to enumerate; those components are left
+    // out of the combination, so the rest is then approximate.
+    const vector<float> &mineProbabilities(const Board &target, int mines) {
+        start(target, mines);
+        positions++;
+        do {
+            propagateSingles();
+        } while (applyPairs() || applyMineCount());
+
+        probabilities.assign(marks.size(), -1);
+        buildComponents();
+
+        // Enumerate or reuse every component
+        map<vector<int>, ComponentCounts> nextCache;
+        vector<const ComponentCounts *> components;
+        int unknown[8], need;
+        for (const vector<int> &group : groups) {
+            vector<int> key;
+            for (int a : group) {
+                int count = collect(a, unknown, need);
+                key.push_back(a);
+                key.push_back(need);
+                key.insert(key.end(), unknown, unknown + count);
+                key.push_back(-1);
+            }
+            auto cached = cache.find(key);
+            ComponentCounts &entry = nextCache[key];
+            if (cached != cache.end()) entry = move(cached->second);
+            else enumerateGroup(group, entry);
+            if (entry.complete) components.push_back(&entry);
+        }
+        cache.swap(nextCache);
+
+        // Everything hidden and unknown outside the frontier is interior
+        int knownMines = 0;
+        for (int cell : frontier) localId[cell] = 0;
+        vector<int> interior;
+        for (int n = 0; n < target.size(); ++n) {
+            int idx = target.indexOfNth(n);
+            if (target.isRevealed(idx)) continue;
+            if (marks[idx] == Mine) {
+                knownMines++;
+                probabilities[idx] = 1;
+            } else if (marks[idx] == Safe) {
+                probabilities[idx] = 0;
+            } else if (localId[idx] < 0) {
+                interior.push_back(idx);
+            }
+        }
+        for (int cell : frontier) localId[cell] = -1;
+
+        // Each component's counts are scaled to a maximum of 1; the scale
+        // cancels out of every ratio below
+        size_t m = components.size();
+        vector<vector<double>> scaled(m);
+        for (size_t j = 0; j < m; ++j) {
+            double top = *max_element(components[j]->ways.begin(), components[j]->ways.end());
+            scaled[j] = components[j]->ways;
+            for (double &ways : scaled[j]) ways /= top > 0 ? top : 1;
+        }
+
+        // prefix[j] and suffix[j] convolve the components before and from j
+        vector<vector<double>> prefix(m + 1, vector<double>(1, 1.0)), suffix(m + 1, vector<double>(1, 1.0));
+        for (size_t j = 0; j < m; ++j) prefix[j + 1] = convolve(prefix[j], scaled[j]);
+        for (size_t j = m; j-- > 0;) suffix[j] = convolve(scaled[j], suffix[j + 1]);
+        const vector<double> &all = prefix[m];
+
+        // interiorWays[t]: ways to put the mines left over after t frontier
+        // mines into the interior, relative to the largest such count
+        int left = mines - knownMines, spread = static_cast<int>(interior.size());
+        vector<double> interiorWays(all.size(), 0);
+        double shift = -1e300;
+        for (size_t t = 0; t < all.size(); ++t) {
+            int rest = left - static_cast<int>(t);
+            if (rest >= 0 && rest <= spread) shift = max(shift, logChoose(spread, rest));
+        }
+        for (size_t t = 0; t < all.size(); ++t) {
+            int rest = left - static_cast<int>(t);
+            if (rest >= 0 && rest <= spread) interiorWays[t] = exp(logChoose(spread, rest) - shift);
+        }
+
+        double total = 0, interiorMines = 0;
+        for (size_t t = 0; t < all.size(); ++t) {
+            total += all[t] * interiorWays[t];
+            interiorMines += all[t] * interiorWays[t] * (left - static_cast<int>(t));
+        }
+        if (total <= 0) return probabilities; // Numbers contradict the mine total
+
+        for (int idx : interior) probabilities[idx] = static_cast<float>(interiorMines / total / spread);
+
+        for (size_t j = 0; j < m; ++j) {
+            const ComponentCounts &component = *components[j];
+            size_t n = component.cells.size();
+            double top = *max_element(component.ways.begin(), component.ways.end());
+            double scale = top > 0 ? 1 / top : 1;
+
+            // Weight of this component holding k mines, over all the rest
+            vector<double> others = convolve(prefix[j], suffix[j + 1]);
+            vector<double> weight(n + 1, 0);
+            for (size_t k = 0; k <= n; ++k) {
+                for (size_t s = 0; s < others.size() && k + s < interiorWays.size(); ++s) {
+                    weight[k] += others[s] * interiorWays[k + s];
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                double mineWeight = 0;
+                for (size_t k = 0; k <= n; ++k) mineWeight += component.cellWays[k * n + i] * scale * weight[k];
+                probabilities[component.cells[i]] = static_cast<float>(mineWeight / total);
+            }
+        }
+        return probabilities;
+    }
+
+    // Number of positions analyzed so far (each analyze or play step)
+    unsigned long long getPositions() const { return positions; }
+};
+
+#endif //SOLVER_H
@@ -0,0 +1,68 @@
+// Migrates an old "MM:SS,name" leaderboard through LeaderboardStore and
+// checks that its times stay on the board the game asked about. Exits
+// non-zero on failure.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "leaderboardStore.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string &what) {
+    if (!ok) {
+        cerr << "FAIL: " << what << "\n";
+        failures++;
+    }
+}
+
+// The entry for name on the given board, or nullptr
+static const LeaderboardEntry *findEntry(const vector<LeaderboardEntry> &entries, int cols, int rows, int mines,
+                                         const string &name) {
+    for (const LeaderboardEntry &entry : entries) {
+        if (entry.sameBoard(cols, rows, mines) && entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+int main() {
+    const string path = "leaderboard_store_test.txt";
+    {
+        ofstream legacy(path, ios::trunc);
+        legacy << "01:05, Alice\n00:59,Bob\n";
+    }
+
+    {
+        LeaderboardStore store(path, chrono::milliseconds(0));
+        unsigned long ticket = store.submit(25, 16, 50, "Carl", 30000);
+        store.flush();
+        check(store.getWrites() == 1, "the submitted score is written once");
+
+        LeaderboardTable table;
+        check(store.poll(table), "a table is published");
+        check(table.revision == ticket, "the published table includes the score");
+        check(table.cols == 25 && table.rows == 16 && table.mines == 50, "the table is for the submitted board");
+        check(table.entries.size() == 3, "the legacy times are in the submitted board's table");
+    }
+
+    // The rewritten file credits the legacy times to the board they were read for
+    Leaderboard reloaded(path);
+    reloaded.setBoard(1, 1, 1); // Nothing legacy is left to credit elsewhere
+    check(reloaded.load(), "the migrated file loads");
+    const vector<LeaderboardEntry> &entries = reloaded.getAllEntries();
+    check(entries.size() == 3, "no entry is lost in the migration");
+    const LeaderboardEntry *alice = findEntry(entries, 25, 16, 50, "Alice");
+    const LeaderboardEntry *bob = findEntry(entries, 25, 16, 50, "Bob");
+    const LeaderboardEntry *carl = findEntry(entries, 25, 16, 50, "Carl");
+    check(alice && alice->millis == 65000, "Alice keeps 01:05 on 25x16/50");
+    check(bob && bob->millis == 59000, "Bob keeps 00:59 on 25x16/50");
+    check(carl && carl->millis == 30000, "Carl's new time is on 25x16/50");
+
+    remove(path.c_str());
+    if (failures == 0) cout << "leaderboard store migration: ok\n";
+    return failures == 0 ? 0 : 1;
+}
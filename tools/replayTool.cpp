@@ -0,0 +1,130 @@
+// Plays back every game in a replay archive through GameEngine with no
+// rendering, reporting outcomes, times and encoding size. With
+// --leaderboard, checks that each leaderboard time matches a recorded win
+// by that player.
+//
+// usage: mines_replay [--threads T] [--list] [--leaderboard PATH] [ARCHIVE]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+#include "replay.h"
+#include "leaderboard.h"
+#include "workStealing.h"
+
+using namespace std;
+
+struct ReplayOptions {
+    string archive = "files/replays.bin";
+    string leaderboard;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    bool list = false;
+};
+
+static ReplayOptions parseArguments(int argc, char **argv) {
+    ReplayOptions options;
+    bool archiveSet = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) throw invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--threads") options.threads = static_cast<unsigned>(max(1, stoi(value())));
+        else if (arg == "--list") options.list = true;
+        else if (arg == "--leaderboard") options.leaderboard = value();
+        else if (arg.compare(0, 2, "--") == 0 || archiveSet) throw invalid_argument("Unexpected argument " + arg);
+        else {
+            options.archive = arg;
+            archiveSet = true;
+        }
+    }
+    return options;
+}
+
+static const char *stateName(GameState state) {
+    switch (state) {
+        case GameState::Won: return "won";
+        case GameState::Lost: return "lost";
+        case GameState::Playing: break;
+    }
+    return "unfinished";
+}
+
+// Every leaderboard time should be a recorded win by the same player on the
+// same board. Times carried over from the old whole-second format match the
+// floor of the win's time.
+static int checkLeaderboard(const string &path, const vector<Replay> &games,
+                            const vector<ReplayPlayer::Outcome> &outcomes) {
+    Leaderboard leaderboard(path);
+    leaderboard.load();
+    int unverified = 0;
+    for (const LeaderboardEntry &entry : leaderboard.getAllEntries()) {
+        bool found = false;
+        for (size_t i = 0; i < games.size() && !found; ++i) {
+            const Replay &game = games[i];
+            uint32_t millis = outcomes[i].millis;
+            found = outcomes[i].state == GameState::Won && game.player == entry.name &&
+                    entry.sameBoard(game.cols, game.rows, game.mines) &&
+                    (millis == entry.millis || (entry.millis % 1000 == 0 && millis / 1000 * 1000 == entry.millis));
+        }
+        cout << (found ? "verified   " : "UNVERIFIED ") << entry.cols << "x" << entry.rows << "/" << entry.mines << " "
+             << Leaderboard::formatTime(entry.millis) << " " << entry.name << "\n";
+        if (!found) unverified++;
+    }
+    return unverified;
+}
+
+int main(int argc, char **argv) {
+    ReplayOptions options;
+    vector<Replay> games;
+    try {
+        options = parseArguments(argc, argv);
+        games = Replay::loadAll(options.archive);
+    } catch (const exception &e) {
+        cerr << "usage: mines_replay [--threads T] [--list] [--leaderboard PATH] [ARCHIVE]\n" << e.what() << "\n";
+        return 1;
+    }
+
+    vector<ReplayPlayer::Outcome> outcomes(games.size());
+    vector<GameEngine> engines(options.threads);
+    auto start = chrono::steady_clock::now();
+    parallelForStealing(games.size(), options.threads, 16, [&](unsigned w, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) outcomes[i] = ReplayPlayer::run(games[i], engines[w]);
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t won = 0, lost = 0, moves = 0, bytes = 0;
+    vector<uint8_t> encoded;
+    for (size_t i = 0; i < games.size(); ++i) {
+        const Replay &game = games[i];
+        const ReplayPlayer::Outcome &outcome = outcomes[i];
+        if (outcome.state == GameState::Won) won++;
+        if (outcome.state == GameState::Lost) lost++;
+        moves += outcome.moves;
+        encoded.clear();
+        game.encode(encoded);
+        bytes += encoded.size();
+
+        if (options.list) {
+            cout << setw(6) << i << "  " << game.cols << "x" << game.rows << "/" << game.mines
+                 << "  " << left << setw(11) << stateName(outcome.state) << right << fixed << setprecision(3)
+                 << setw(9) << outcome.millis / 1000.0 << " s" << setw(6) << outcome.moves << " moves"
+                 << setw(7) << encoded.size() << " bytes  " << game.player
+                 << (outcome.ignored ? "  (" + to_string(outcome.ignored) + " moves had no effect)" : "") << "\n";
+        }
+    }
+
+    cout << games.size() << " games: " << won << " won, " << lost << " lost, "
+         << games.size() - won - lost << " unfinished\n";
+    if (moves > 0) {
+        cout << fixed << setprecision(2) << static_cast<double>(bytes) / moves << " bytes/move including headers, "
+             << setprecision(0) << games.size() / seconds << " games/s, " << moves / seconds << " moves/s\n";
+    }
+
+    if (!options.leaderboard.empty() && checkLeaderboard(options.leaderboard, games, outcomes) > 0) return 2;
+    return 0;
+}
@@ -0,0 +1,283 @@
+// Plays many headless games with a chosen strategy to measure generator
+// and strategy quality: win rate, average 3BV and time per game. Games go
+// through GameEngine, the same rules the game window uses, and are spread
+// over a work-stealing pool. Game i always uses the same seed, so results
+// do not depend on the thread count.
+//
+// usage: mines_sim [--games N] [--threads T] [--board COLS ROWS MINES]
+//                  [--strategy random|solver|probability] [--seed S]
+//                  [--noguess] [--scaling]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include "gameEngine.h"
+#include "noGuessGenerator.h"
+#include "solver.h"
+#include "workStealing.h"
+
+using namespace std;
+
+// A way of playing one game to the end. Each worker owns one instance.
+class Strategy {
+public:
+    virtual ~Strategy() {}
+    virtual void play(GameEngine &engine, FastRng &rng) = 0;
+};
+
+// A uniformly random hidden cell, skipping proven mines if known is given.
+// Tries a few blind picks first since most of the board is usually hidden.
+static int randomHiddenCell(const Board &board, FastRng &rng, const Solver::Result *known = nullptr) {
+    auto usable = [&](int idx) {
+        return !board.isRevealed(idx) &&
+               (!known || find(known->mines.begin(), known->mines.end(), idx) == known->mines.end());
+    };
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        int idx = board.indexOfNth(static_cast<int>(rng.below(static_cast<uint32_t>(board.size()))));
+        if (usable(idx)) return idx;
+    }
+    vector<int> hidden;
+    for (int n = 0; n < board.size(); ++n) {
+        if (usable(board.indexOfNth(n))) hidden.push_back(board.indexOfNth(n));
+    }
+    return hidden.empty() ? -1 : hidden[rng.below(static_cast<uint32_t>(hidden.size()))];
+}
+
+// Clicks random hidden cells; a baseline for the others
+class RandomStrategy : public Strategy {
+public:
+    void play(GameEngine &engine, FastRng &rng) override {
+        const Board &board = engine.getBoard();
+        while (!engine.isGameOver()) {
+            int idx = randomHiddenCell(board, rng);
+            engine.reveal(board.rowOf(idx), board.colOf(idx));
+        }
+    }
+};
+
+// Opens the center, plays every proven move and guesses when stuck:
+// uniformly among the unproven cells, or with probabilities on the
+// cell least likely to be a mine
+class SolverStrategy : public Strategy {
+private:
+    Solver solver;
+    bool useProbabilities;
+
+public:
+    explicit SolverStrategy(bool useProbabilities) : useProbabilities(useProbabilities) {}
+
+    void play(GameEngine &engine, FastRng &rng) override {
+        const Board &board = engine.getBoard();
+        engine.reveal(engine.getRows() / 2, engine.getCols() / 2);
+        while (!engine.isGameOver()) {
+            const Solver::Result &result = solver.analyze(board, engine.getMines());
+            if (!result.safe.empty()) {
+                for (int idx : result.safe) engine.reveal(board.rowOf(idx), board.colOf(idx));
+                continue;
+            }
+
+            int guess = -1;
+            if (useProbabilities) {
+                const vector<float> &chance = solver.mineProbabilities(board, engine.getMines());
+                float best = 2;
+                for (int n = 0; n < board.size(); ++n) {
+                    int idx = board.indexOfNth(n);
+                    if (!board.isRevealed(idx) && chance[idx] >= 0 && chance[idx] < best) {
+                        best = chance[idx];
+                        guess = idx;
+                    }
+                }
+            }
+            if (guess < 0) guess = randomHiddenCell(board, rng, &result);
+            engine.reveal(board.rowOf(guess), board.colOf(guess));
+        }
+    }
+};
+
+static unique_ptr<Strategy> makeStrategy(const string &name) {
+    if (name == "random") return unique_ptr<Strategy>(new RandomStrategy());
+    if (name == "solver") return unique_ptr<Strategy>(new SolverStrategy(false));
+    if (name == "probability") return unique_ptr<Strategy>(new SolverStrategy(true));
+    throw invalid_argument("Unknown strategy " + name);
+}
+
+// Minimum clicks to clear the board: one per opening (connected zero
+// region) plus one per safe number not bordering an opening
+static int boardValue3BV(const Board &board, vector<uint8_t> &seen, vector<int> &stack) {
+    seen.assign(static_cast<size_t>(board.getRows() + 2) * board.getStride(), 0);
+    const int *offsets = board.neighborOffsets();
+    int clicks = 0;
+    for (int n = 0; n < board.size(); ++n) {
+        int start = board.indexOfNth(n);
+        if (seen[start] || board.isMine(start) || board.adjacentMines(start) != 0) continue;
+        clicks++;
+        seen[start] = 1;
+        stack.assign(1, start);
+        while (!stack.empty()) {
+            int idx = stack.back();
+            stack.pop_back();
+            for (int i = 0; i < 8; ++i) {
+                int next = idx + offsets[i];
+                if (seen[next] || board.isBorder(next)) continue;
+                seen[next] = 1;
+                if (board.adjacentMines(next) == 0) stack.push_back(next);
+            }
+        }
+    }
+    for (int n = 0; n < board.size(); ++n) {
+        int idx = board.indexOfNth(n);
+        if (!seen[idx] && !board.isMine(idx)) clicks++;
+    }
+    return clicks;
+}
+
+struct SimConfig {
+    int cols = 30, rows = 16, mines = 99;
+    unsigned long long games = 100000;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    string strategy = "probability";
+    uint64_t seed = 1;
+    bool noGuess = false;
+    bool scaling = false;
+};
+
+// Totals for one worker, merged once all games are done
+struct SimTotals {
+    unsigned long long games = 0;
+    unsigned long long wins = 0;
+    unsigned long long value3BV = 0;
+    double gameSeconds = 0;
+
+    void merge(const SimTotals &other) {
+        games += other.games;
+        wins += other.wins;
+        value3BV += other.value3BV;
+        gameSeconds += other.gameSeconds;
+    }
+};
+
+// Everything one worker owns: rules, generator scratch and strategy
+struct SimWorker {
+    GameEngine engine;
+    FastRng rng;
+    unique_ptr<Strategy> strategy;
+    unique_ptr<NoGuessGenerator> generator;
+    vector<uint8_t> seen;
+    vector<int> stack;
+    SimTotals totals;
+};
+
+static SimTotals simulate(const SimConfig &config, unsigned threads, double &seconds) {
+    vector<unique_ptr<SimWorker>> workers;
+    for (unsigned w = 0; w < threads; ++w) {
+        unique_ptr<SimWorker> worker(new SimWorker());
+        worker->engine.configure(config.cols, config.rows, config.mines);
+        worker->engine.setFirstClickSafe(true);
+        worker->strategy = makeStrategy(config.strategy);
+        if (config.noGuess) {
+            // One generator thread per worker; the workers already fill the cores
+            NoGuessGenerator *generator = new NoGuessGenerator(1);
+            worker->generator.reset(generator);
+            worker->engine.setSeedPicker([generator, &config](uint64_t seed, int row, int col) {
+                uint64_t chosen;
+                generator->generate(config.cols, config.rows, config.mines, row, col, seed, chosen);
+                return chosen;
+            });
+        }
+        workers.push_back(move(worker));
+    }
+
+    auto start = chrono::steady_clock::now();
+    parallelForStealing(config.games, threads, 64, [&](unsigned w, size_t begin, size_t end) {
+        SimWorker &worker = *workers[w];
+        for (size_t i = begin; i < end; ++i) {
+            auto gameStart = chrono::steady_clock::now();
+            uint64_t gameSeed = NoGuessGenerator::candidateSeed(config.seed, i);
+            // The strategy draws from its own stream; sharing the engine's
+            // seed would replay the numbers that placed the mines
+            worker.rng.seed(FastRng(gameSeed ^ 0x9E3779B97F4A7C15ULL).next());
+            worker.engine.reset(gameSeed);
+            worker.strategy->play(worker.engine, worker.rng);
+
+            worker.totals.games++;
+            if (worker.engine.hasWon()) worker.totals.wins++;
+            worker.totals.value3BV += boardValue3BV(worker.engine.getBoard(), worker.seen, worker.stack);
+            worker.totals.gameSeconds += chrono::duration<double>(chrono::steady_clock::now() - gameStart).count();
+        }
+    });
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    SimTotals sum;
+    for (const auto &worker : workers) sum.merge(worker->totals);
+    return sum;
+}
+
+static SimConfig parseArguments(int argc, char **argv) {
+    SimConfig config;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) throw invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--games") config.games = stoull(value());
+        else if (arg == "--threads") config.threads = static_cast<unsigned>(max(1, stoi(value())));
+        else if (arg == "--board") {
+            config.cols = stoi(value());
+            config.rows = stoi(value());
+            config.mines = stoi(value());
+        }
+        else if (arg == "--strategy") config.strategy = value();
+        else if (arg == "--seed") config.seed = stoull(value());
+        else if (arg == "--noguess") config.noGuess = true;
+        else if (arg == "--scaling") config.scaling = true;
+        else throw invalid_argument("Unknown option " + arg);
+    }
+    GameEngine check(config.cols, config.rows, config.mines);
+    makeStrategy(config.strategy);
+    return config;
+}
+
+int main(int argc, char **argv) {
+    SimConfig config;
+    try {
+        config = parseArguments(argc, argv);
+    } catch (const exception &e) {
+        cerr << "usage: mines_sim [--games N] [--threads T] [--board COLS ROWS MINES]\n"
+                "                 [--strategy random|solver|probability] [--seed S]\n"
+                "                 [--noguess] [--scaling]\n" << e.what() << "\n";
+        return 1;
+    }
+
+    cout << config.strategy << " strategy, " << config.cols << "x" << config.rows << " / " << config.mines
+         << " mines" << (config.noGuess ? " (no-guess boards)" : "") << ", " << config.games << " games\n";
+
+    // With --scaling, repeat the run on 1, 2, 4, ... threads up to the limit
+    vector<unsigned> threadCounts;
+    if (config.scaling) {
+        for (unsigned t = 1; t < config.threads; t *= 2) threadCounts.push_back(t);
+    }
+    threadCounts.push_back(config.threads);
+
+    cout << left << setw(9) << "threads" << setw(10) << "win %" << setw(10) << "avg 3BV"
+         << setw(14) << "us/game" << setw(14) << "games/s" << "efficiency\n";
+    double singleRate = 0;
+    for (unsigned threads : threadCounts) {
+        double seconds = 0;
+        SimTotals totals = simulate(config, threads, seconds);
+        double rate = totals.games / seconds;
+        if (threads == threadCounts.front()) singleRate = rate / threads;
+
+        cout << left << setw(9) << threads << fixed << setprecision(2)
+             << setw(10) << 100.0 * totals.wins / totals.games
+             << setw(10) << static_cast<double>(totals.value3BV) / totals.games
+             << setw(14) << 1e6 * totals.gameSeconds / totals.games
+             << setw(14) << setprecision(0) << rate
+             << setprecision(1) << 100.0 * rate / (singleRate * threads) << "%\n";
+    }
+    return 0;
+}
@@ -1,57 +1,87 @@
-//
-// Created by BTK on 11/24/2024.
-//
-
-#ifndef WINDOW_H
-#define WINDOW_H
-
-#include <SFML/Graphics.hpp>
-#include <string>
-using namespace std;
-class Window {
-protected:
-    sf::RenderWindow window;
-    sf::Font font;
-    int width;
-    int height;
-    string title;
-
-
-    public:
-    Window(int width, int height,const string &title): width(width), height(height), title(title) {
-        window.create(sf::VideoMode(width, height), title, sf::Style::Close);
-
-        if(!font.loadFromFile("files/font.ttf")) {
-            throw std::runtime_error("Could not load font");
-        }
-
-    }
-
-
-    virtual ~Window() {} // window destructor
-
-    virtual void run() = 0;
-
-
-
-    protected: //this one is to set text
-
-    void setText(sf::Text &text,const string& content, float x, float y, unsigned int size, sf::Color color) {
-        text.setFont(font);
-        text.setString(content);
-        text.setCharacterSize(size);
-        text.setFillColor(color);
-        sf::FloatRect textRect = text.getLocalBounds();
-        text.setOrigin(textRect.width/2.0f, textRect.height/2.0f);
-        text.setPosition(x,y);
-
-
-
-    }
-};
-
-
-
-
-
-#endif //WINDOW_H
+//
+// Created by BTK on 11/24/2024.
+//
+
+#ifndef WINDOW_H
+#define WINDOW_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "frameScheduler.h"
+#include "assetManager.h"
+using namespace std;
+class Window {
+protected:
+    sf::RenderWindow window;
+    const sf::Font &font;     // Shared by every window
+    FrameScheduler scheduler; // Redraws only when something changed
+    int width;
+    int height;
+    string title;
+    bool visible = true;
+
+
+    public:
+    Window(int width, int height,const string &title)
+        : font(AssetManager::shared().font("files/font.ttf")), width(width), height(height), title(title) {
+        window.create(sf::VideoMode(width, height), title, sf::Style::Close);
+    }
+
+
+    virtual ~Window() {} // window destructor
+
+    // One event and one frame at a time, so a WindowDispatcher can drive
+    // several windows from a single loop
+    virtual void handleEvent(sf::Event &event) { if (event.type == sf::Event::Closed) window.close(); }
+    virtual void drawFrame() {}
+
+    // Run this window on its own until it is closed or hidden
+    virtual void run() {
+        while (isVisible()) {
+            sf::Event event;
+            while (scheduler.waitEvent(window, event)) handleEvent(event);
+            if (!isVisible()) break;
+            drawFrame();
+            scheduler.frameDrawn();
+        }
+    }
+
+    // Hidden windows keep their contents and come back instantly
+    void show() {
+        visible = true;
+        window.setVisible(true);
+        window.requestFocus();
+        scheduler.markDirty();
+    }
+    void hide() {
+        visible = false;
+        window.setVisible(false);
+    }
+    bool isVisible() const { return visible && window.isOpen(); }
+
+    sf::RenderWindow &getRenderWindow() { return window; }
+    FrameScheduler &getScheduler() { return scheduler; }
+
+
+
+    protected: //this one is to set text
+
+    void setText(sf::Text &text,const string& content, float x, float y, unsigned int size, sf::Color color) {
+        text.setFont(font);
+        text.setString(content);
+        text.setCharacterSize(size);
+        text.setFillColor(color);
+        sf::FloatRect textRect = text.getLocalBounds();
+        text.setOrigin(textRect.width/2.0f, textRect.height/2.0f);
+        text.setPosition(x,y);
+
+
+
+    }
+};
+
+
+
+
+
+#endif //WINDOW_H
@@ -0,0 +1,43 @@
+#ifndef WINDOWDISPATCHER_H
+#define WINDOWDISPATCHER_H
+
+#include <vector>
+#include <algorithm>
+#include <SFML/Graphics.hpp>
+#include "window.h"
+using namespace std;
+
+// Services several windows from one loop on one thread: drains each
+// window's events, draws each visible window whose scheduler has a frame
+// due, then sleeps until the soonest of them could need one. Hidden
+// windows still get their events but are never drawn. Runs until the
+// first window added is closed.
+class WindowDispatcher {
+private:
+    vector<Window *> windows;
+
+public:
+    void add(Window &window) { windows.push_back(&window); }
+
+    void run() {
+        while (!windows.empty() && windows.front()->getRenderWindow().isOpen()) {
+            sf::Time idle = sf::milliseconds(4);
+            for (Window *window : windows) {
+                sf::RenderWindow &target = window->getRenderWindow();
+                FrameScheduler &scheduler = window->getScheduler();
+                sf::Event event;
+                while (target.isOpen() && scheduler.pollEvent(target, event)) window->handleEvent(event);
+                if (!window->isVisible()) continue;
+
+                if (scheduler.frameDue()) {
+                    window->drawFrame();
+                    scheduler.frameDrawn();
+                }
+                idle = min(idle, scheduler.idleTime());
+            }
+            if (idle > sf::Time::Zero) sf::sleep(idle);
+        }
+    }
+};
+
+#endif //WINDOWDISPATCHER_H
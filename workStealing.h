@@ -0,0 +1,79 @@
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Parallel loop over [0, count) with work stealing. Each worker starts
+// with an equal share of the range and takes grain-sized chunks from its
+// front; a worker that runs dry steals the back half of another worker's
+// remaining range, so uneven item costs even out without a shared queue.
+// body(worker, begin, end) is called for each chunk; worker is in
+// [0, threads) and is stable for the thread, so callers can keep
+// per-worker state in a vector indexed by it.
+template <class Body>
+void parallelForStealing(size_t count, unsigned threads, size_t grain, Body body) {
+    struct Range {
+        mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    threads = max(1u, threads);
+    grain = max<size_t>(1, grain);
+    unique_ptr<Range[]> ranges(new Range[threads]);
+    for (unsigned w = 0; w < threads; ++w) {
+        ranges[w].begin = count * w / threads;
+        ranges[w].end = count * (w + 1) / threads;
+    }
+
+    auto work = [&](unsigned self) {
+        Range &own = ranges[self];
+        while (true) {
+            size_t begin = 0, end = 0;
+            {
+                lock_guard<mutex> guard(own.lock);
+                if (own.begin < own.end) {
+                    begin = own.begin;
+                    end = min(own.end, begin + grain);
+                    own.begin = end;
+                }
+            }
+            if (begin < end) {
+                body(self, begin, end);
+                continue;
+            }
+
+            // Out of work: steal half of the first victim with some left
+            bool stolen = false;
+            for (unsigned k = 1; k < threads && !stolen; ++k) {
+                Range &victim = ranges[(self + k) % threads];
+                lock_guard<mutex> guard(victim.lock);
+                size_t remaining = victim.end - victim.begin;
+                if (remaining == 0) continue;
+                size_t middle = victim.begin + remaining / 2;
+                begin = middle;
+                end = victim.end;
+                victim.end = middle;
+                stolen = true;
+            }
+            if (!stolen) return;
+
+            lock_guard<mutex> guard(own.lock);
+            own.begin = begin;
+            own.end = end;
+        }
+    };
+
+    vector<thread> workers;
+    for (unsigned w = 1; w < threads; ++w) workers.emplace_back(work, w);
+    work(0);
+    for (thread &worker : workers) worker.join();
+}
+
+#endif //WORKSTEALING_H